@@ -4,13 +4,51 @@
 #include <ctime>
 #include <cmath>
 #include <iomanip>
+#include <cstdlib>
+#include <climits>
+#include <new>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <chrono>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
 
 
 using namespace std;
 
-const int MAX_ROWS = 50;
-const int MAX_COLS = 50;
-const int MAX_NODES = 2500;
+// All maze, graph and search storage is sized at runtime from the input.
+// These only bound what is safe to print.
+const int MAX_DISPLAY_CELLS = 100000;      // Larger mazes are not echoed to the console
+const int MAX_DEGREE = 4;                  // 4-directional movement
 
 
 // ==================== NODE STRUCTURES ====================
@@ -48,6 +86,128 @@ struct AdjListNode {
 
 };
 
+// ==================== NODE POOL ====================
+// PURPOSE: Slab allocator for the nodes of linked structures
+// Nodes are carved out of large slabs instead of one new per node. Released
+// nodes go on a free list and are handed out again before a new slab is
+// taken, and destroying the pool frees every slab at once, so nodes still in
+// use are dropped without their destructors (T must not own other memory).
+// USED IN: Linked stack/queue (ListNode), Graph (AdjListNode), HashMap entries
+
+template <typename T>
+class NodePool {
+
+private:
+
+    union Slot {
+        Slot* nextFree;   // While the slot is on the free list
+        T object;         // While the slot is handed out
+        Slot() {}
+        ~Slot() {}
+    };
+
+    struct Slab {
+        Slot* slots;
+        int count;
+        Slab* next;
+    };
+
+    Slab* slabs;          // Newest slab first
+    int slabUsed;         // Slots of the newest slab handed out so far
+    Slot* freeList;
+
+    // Counters: heap allocations are exactly slabCount
+    long long slabCount;
+    long long createdCount;
+    long long reusedCount;
+    long long liveCount;
+
+    void addSlab() {
+
+        // Slabs double in size (64 .. 65536 slots) so small structures stay small
+        int count = slabs == NULL ? 64 : slabs->count * 2;
+        if (count > 65536) count = 65536;
+        Slab* slab = new Slab;
+        slab->slots = new Slot[count];
+        slab->count = count;
+        slab->next = slabs;
+        slabs = slab;
+        slabUsed = 0;
+        slabCount++;
+
+    }
+
+public:
+
+    NodePool() : slabs(NULL), slabUsed(0), freeList(NULL), slabCount(0), createdCount(0),
+        reusedCount(0), liveCount(0) {}
+
+    template <typename... Args>
+    T* create(Args... args) {
+
+        // Construct a node in a free slot, taking a new slab only when none is left
+        Slot* slot;
+        if (freeList != NULL) {
+            slot = freeList;
+            freeList = slot->nextFree;
+            reusedCount++;
+        } else {
+            if (slabs == NULL || slabUsed == slabs->count) addSlab();
+            slot = &slabs->slots[slabUsed++];
+        }
+        createdCount++;
+        liveCount++;
+        return new (&slot->object) T(args...);
+
+    }
+
+    void release(T* node) {
+
+        // Return a node to the free list (no heap call)
+        node->~T();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->nextFree = freeList;
+        freeList = slot;
+        liveCount--;
+
+    }
+
+    long long getSlabCount() {
+
+        return slabCount;
+
+    }
+
+    long long getCreatedCount() {
+
+        return createdCount;
+
+    }
+
+    long long getReusedCount() {
+
+        return reusedCount;
+
+    }
+
+    long long getLiveCount() {
+
+        return liveCount;
+
+    }
+
+    ~NodePool() {
+
+        while (slabs != NULL) {
+            Slab* next = slabs->next;
+            delete[] slabs->slots;
+            delete slabs;
+            slabs = next;
+        }
+
+    }
+};
+
 // ==================== STACK IMPLEMENTATION ====================
 // PURPOSE: LIFO (Last In First Out) data structure for DFS algorithm
 
@@ -55,21 +215,40 @@ class StackArray {
 
     // PURPOSE: Stack using array (demonstrates array-based implementation)
     // USED IN: DFS traversal, path reconstruction
+    // Grows by doubling when full, so nothing pushed is ever dropped
 private:
 
-    int arr[MAX_NODES];
+    int* arr;
+    int capacity;
     int top;
 
+    void grow() {
+
+        // Double the capacity and copy existing elements over
+        int newCapacity = capacity * 2;
+        int* newArr = new int[newCapacity];
+        for (int i = 0; i <= top; i++) {
+            newArr[i] = arr[i];
+        }
+        delete[] arr;
+        arr = newArr;
+        capacity = newCapacity;
+
+    }
+
 public:
 
-    StackArray() : top(-1) {}
+    StackArray(int initialCapacity = 64) : capacity(initialCapacity > 0 ? initialCapacity : 1), top(-1) {
+        arr = new int[capacity];
+    }
     
     void push(int val) {
 
         // Add element to top of stack
-        if (top < MAX_NODES - 1) {
-            arr[++top] = val;
+        if (top == capacity - 1) {
+            grow();
         }
+        arr[++top] = val;
 
     }
     
@@ -96,6 +275,12 @@ public:
 
     }
 
+    ~StackArray() {
+
+        delete[] arr;
+
+    }
+
 };
 
 
@@ -103,20 +288,25 @@ class StackLinkedList {
 
     // PURPOSE: Stack using linked list (demonstrates dynamic memory allocation)
     // USED IN: DFS traversal alternative implementation
+    // Nodes come from a NodePool: a shared one if given, otherwise its own
 
 private:
 
     ListNode* top;
+    NodePool<ListNode>* pool;
+    bool ownsPool;
 
 public:
 
-    StackLinkedList() : top(NULL) {}
+    StackLinkedList(NodePool<ListNode>* nodePool = NULL) : top(NULL), pool(nodePool), ownsPool(nodePool == NULL) {
+        if (ownsPool) pool = new NodePool<ListNode>();
+    }
 
     
     void push(int val) {
 
         // Add element to top (insert at beginning)
-        ListNode* newNode = new ListNode(val);
+        ListNode* newNode = pool->create(val);
         newNode->next = top;
         top = newNode;
 
@@ -131,7 +321,7 @@ public:
         int val = temp->data;
         top = top->next;
 
-        delete temp;
+        pool->release(temp);
         return val;
 
     }
@@ -144,11 +334,15 @@ public:
     
     ~StackLinkedList() {
 
-        // Cleanup: delete all nodes
+        // Cleanup: an own pool frees its slabs in one go, a shared pool gets the nodes back
+        if (ownsPool) {
+            delete pool;
+            return;
+        }
         while (top != NULL) {
             ListNode* temp = top;
             top = top->next;
-            delete temp;
+            pool->release(temp);
 
         }
 
@@ -163,24 +357,45 @@ class QueueArray {
 
     // PURPOSE: Queue using circular array
     // USED IN: BFS traversal (level-by-level exploration)
+    // Grows by doubling when full, so nothing enqueued is ever dropped
 
 private:
 
-    int arr[MAX_NODES];
+    int* arr;
+    int capacity;
     int front, rear, size;
 
+    void grow() {
+
+        // Unwrap the circular buffer into a larger array
+        int newCapacity = capacity * 2;
+        int* newArr = new int[newCapacity];
+        for (int i = 0; i < size; i++) {
+            newArr[i] = arr[(front + i) % capacity];
+        }
+        delete[] arr;
+        arr = newArr;
+        capacity = newCapacity;
+        front = 0;
+        rear = size - 1;
+
+    }
+
 public:
 
-    QueueArray() : front(0), rear(-1), size(0) {}
+    QueueArray(int initialCapacity = 64) : capacity(initialCapacity > 0 ? initialCapacity : 1), front(0), rear(-1), size(0) {
+        arr = new int[capacity];
+    }
     
     void enqueue(int val) {
 
         // Add element to rear of queue
-        if (size < MAX_NODES) {
-            rear = (rear + 1) % MAX_NODES;
-            arr[rear] = val;
-            size++;
+        if (size == capacity) {
+            grow();
         }
+        rear = (rear + 1) % capacity;
+        arr[rear] = val;
+        size++;
 
     }
     
@@ -189,7 +404,7 @@ public:
         // Remove and return front element
         if (size == 0) return -1;
         int val = arr[front];
-        front = (front + 1) % MAX_NODES;
+        front = (front + 1) % capacity;
         size--;
         return val;
 
@@ -200,27 +415,39 @@ public:
         return size == 0;
 
     }
+
+    ~QueueArray() {
+
+        delete[] arr;
+
+    }
 };
 
 class QueueLinkedList {
 
     // PURPOSE: Queue using linked list
     // USED IN: BFS traversal alternative implementation
+    // Nodes come from a NodePool: a shared one if given, otherwise its own
 
 private:
 
     ListNode* front;
     ListNode* rear;
+    NodePool<ListNode>* pool;
+    bool ownsPool;
 
 public:
 
-    QueueLinkedList() : front(NULL), rear(NULL) {}
+    QueueLinkedList(NodePool<ListNode>* nodePool = NULL) : front(NULL), rear(NULL), pool(nodePool),
+        ownsPool(nodePool == NULL) {
+        if (ownsPool) pool = new NodePool<ListNode>();
+    }
 
     
     void enqueue(int val) {
 
         // Add element to rear
-        ListNode* newNode = new ListNode(val);
+        ListNode* newNode = pool->create(val);
 
         if (rear == NULL) {
 
@@ -247,7 +474,7 @@ public:
 
         if (front == NULL) rear = NULL;
 
-        delete temp;
+        pool->release(temp);
         return val;
     }
     
@@ -259,11 +486,15 @@ public:
     
     ~QueueLinkedList() {
 
-        // Cleanup: delete all nodes
+        // Cleanup: an own pool frees its slabs in one go, a shared pool gets the nodes back
+        if (ownsPool) {
+            delete pool;
+            return;
+        }
         while (front != NULL) {
             ListNode* temp = front;
             front = front->next;
-            delete temp;
+            pool->release(temp);
         }
 
     }
@@ -271,555 +502,8365 @@ public:
 };
 
 
-// ==================== HASH MAP FOR COORDINATES ====================
-// PURPOSE: Fast lookup of node ID from maze coordinates (row, col)
-// USED IN: Converting maze grid positions to graph node IDs in O(1) time
+// ==================== PRIORITY QUEUE ====================
+// PURPOSE: Min-priority queue keyed per node, for best-first searches
+// 4-ary heap in one flat array: the four children of slot i are 4i+1 .. 4i+4,
+// so a sift-down compares entries that share a cache line, and the tree is
+// half as deep as a binary heap. pos[] maps each node to its slot so a
+// node's key can be lowered in place.
+// USED IN: A* search
 
-class HashMap {
+class IndexedMinHeap {
 
 private:
 
-    static const int TABLE_SIZE = 1009;  // Prime number for better distribution
+    struct HeapEntry {
+        long long key;
+        int node;
+    };
 
-    struct Entry {
-        // PURPOSE: Store coordinate-to-nodeID mapping
-        int row, col, nodeId;
-        Entry* next;  // For collision handling (chaining)
-        Entry(int r, int c, int id) : row(r), col(c), nodeId(id), next(NULL) {}
+    HeapEntry* heap;
+    int* pos;          // Slot of each node, -1 when not in the heap
+    int size;
+    int capacity;
 
-    };
-    Entry* table[TABLE_SIZE];
-    
-    int hash(int row, int col) {
+    void place(int slot, HeapEntry entry) {
 
-        // PURPOSE: Convert (row, col) to array index
-        return (row * 1000 + col) % TABLE_SIZE;
+        heap[slot] = entry;
+        pos[entry.node] = slot;
 
     }
-    
-public:
-    HashMap() {
 
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            table[i] = NULL;
+    void siftUp(int slot) {
 
+        HeapEntry entry = heap[slot];
+        while (slot > 0) {
+            int parentSlot = (slot - 1) / 4;
+            if (heap[parentSlot].key <= entry.key) break;
+            place(slot, heap[parentSlot]);
+            slot = parentSlot;
         }
-    }
-    
-    void insert(int row, int col, int nodeId) {
-
-        // PURPOSE: Store mapping (row, col) -> nodeId
-        int idx = hash(row, col);
-        Entry* newEntry = new Entry(row, col, nodeId);
-        newEntry->next = table[idx];
-        table[idx] = newEntry;
+        place(slot, entry);
 
     }
-    
-    int get(int row, int col) {
 
-        // PURPOSE: Retrieve nodeId for given (row, col)
-        int idx = hash(row, col);
-        Entry* curr = table[idx];
-        while (curr != NULL) {
-            if (curr->row == row && curr->col == col) {
-                return curr->nodeId;
+    void siftDown(int slot) {
+
+        HeapEntry entry = heap[slot];
+        while (true) {
+            int first = 4 * slot + 1;
+            if (first >= size) break;
+            int last = first + 4 < size ? first + 4 : size;
+            int best = first;
+            for (int child = first + 1; child < last; child++) {
+                if (heap[child].key < heap[best].key) best = child;
             }
-            curr = curr->next;
+            if (heap[best].key >= entry.key) break;
+            place(slot, heap[best]);
+            slot = best;
         }
-        return -1;  // Not found
+        place(slot, entry);
 
     }
-    
-    ~HashMap() {
 
-        // Cleanup: delete all entries
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            Entry* curr = table[i];
-            while (curr != NULL) {
-                Entry* temp = curr;
-                curr = curr->next;
-                delete temp;
-            }
-        }
-    }
+public:
 
-};
+    IndexedMinHeap(int nodeCapacity) : size(0), capacity(nodeCapacity > 0 ? nodeCapacity : 1) {
+        heap = new HeapEntry[capacity];
+        pos = new int[capacity];
+        for (int i = 0; i < capacity; i++) pos[i] = -1;
+    }
 
-// ==================== GRAPH CLASS ====================
-class Graph {
+    bool isEmpty() {
 
-private:
-    AdjListNode* adjList[MAX_NODES];
-    int nodeCount;
-    int nodeRows[MAX_NODES];
-    int nodeCols[MAX_NODES];
-    
-public:
+        return size == 0;
 
-    Graph() : nodeCount(0) {
-        for (int i = 0; i < MAX_NODES; i++) {
-            adjList[i] = NULL;
-        }
     }
-    
-    int addNode(int row, int col) {
 
-        int id = nodeCount;
-        nodeRows[id] = row;
-        nodeCols[id] = col;
-        nodeCount++;
-        return id;
+    bool contains(int node) {
+
+        return pos[node] != -1;
 
     }
-    
-    void addEdge(int src, int dest, int weight) {
 
-        AdjListNode* newNode = new AdjListNode(dest, weight);
-        newNode->next = adjList[src];
-        adjList[src] = newNode;
+    void push(int node, long long key) {
+
+        // Insert node, or lower its key if it is already queued
+        if (pos[node] != -1) {
+            if (key < heap[pos[node]].key) {
+                heap[pos[node]].key = key;
+                siftUp(pos[node]);
+            }
+            return;
+        }
+        HeapEntry entry;
+        entry.key = key;
+        entry.node = node;
+        place(size, entry);
+        size++;
+        siftUp(size - 1);
 
     }
-    
-    int getNodeCount() { 
 
-        return nodeCount;
+    long long minKey() {
 
-     }
-    
-    AdjListNode* getAdjList(int node) {
+        // Key of the node popMin would return (the heap must not be empty)
+        return heap[0].key;
 
-         return adjList[node]; 
+    }
 
-        }
-    
-    void getNodeCoords(int node, int& row, int& col) {
+    void remove(int node) {
 
-        row = nodeRows[node];
-        col = nodeCols[node];
+        // Take node out of the heap if it is queued
+        int slot = pos[node];
+        if (slot == -1) return;
+        pos[node] = -1;
+        size--;
+        if (slot < size) {
+            HeapEntry last = heap[size];
+            place(slot, last);
+            siftUp(slot);
+            siftDown(pos[last.node]);
+        }
 
     }
-    
-    ~Graph() {
 
-        for (int i = 0; i < nodeCount; i++) {
-            AdjListNode* curr = adjList[i];
-            while (curr != NULL) {
-                AdjListNode* temp = curr;
-                curr = curr->next;
-                delete temp;
+    int popMin() {
 
-            }
+        // Remove and return the node with the smallest key
+        if (size == 0) return -1;
+        int node = heap[0].node;
+        pos[node] = -1;
+        size--;
+        if (size > 0) {
+            heap[0] = heap[size];
+            siftDown(0);
         }
+        return node;
+
     }
-};
 
-// ==================== MAZE CLASS ====================
-class Maze {
+    void clear() {
 
-private:
+        // Empty the heap in time proportional to what is still queued,
+        // so one heap can serve many searches
+        for (int i = 0; i < size; i++) pos[heap[i].node] = -1;
+        size = 0;
 
-    char grid[MAX_ROWS][MAX_COLS];
-    int rows, cols;
-    int startRow, startCol;
-    int endRow, endCol;
-    
-public:
-    Maze() : rows(0), cols(0), startRow(-1), startCol(-1), endRow(-1), endCol(-1) {}
-    
-    bool loadFromFile(const char* filename) {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Cannot open file " << filename << endl;
-            return false;
-        }
-        
-        rows = 0;
-        cols = 0;
-        char line[MAX_COLS + 2];
-        
-        while (file.getline(line, MAX_COLS + 2) && rows < MAX_ROWS) {
-            int len = strlen(line);
-            if (len > cols) cols = len;
-            
-            for (int j = 0; j < len; j++) {
-                grid[rows][j] = line[j];
-                if (line[j] == 'S') {
-                    startRow = rows;
-                    startCol = j;
-                } else if (line[j] == 'E') {
-                    endRow = rows;
-                    endCol = j;
-                }
-            }
-            rows++;
-        }
-        
-        file.close();
-        
-        if (startRow == -1 || endRow == -1) {
-            cout << "Error: Start (S) or End (E) not found in maze!" << endl;
-            return false;
-        }
-        
-        return true;
-    }
-    
-    void display() {
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                cout << grid[i][j];
-            }
-            cout << endl;
-        }
-    }
-    
-    void displayWithPath(int path[], int pathLen) {
-        char tempGrid[MAX_ROWS][MAX_COLS];
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                tempGrid[i][j] = grid[i][j];
-            }
-        }
-        
-        for (int i = 0; i < pathLen; i++) {
-            int r = path[i] / MAX_COLS;
-            int c = path[i] % MAX_COLS;
-            if (tempGrid[r][c] != 'S' && tempGrid[r][c] != 'E') {
-                tempGrid[r][c] = '~';
-            }
-        }
-        
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                cout << tempGrid[i][j];
-            }
-            cout << endl;
-        }
     }
-    
-    char getCell(int r, int c) {
 
-        if (r >= 0 && r < rows && c >= 0 && c < cols) {
+    ~IndexedMinHeap() {
 
-            return grid[r][c];
+        delete[] heap;
+        delete[] pos;
 
-        }
+    }
+};
 
-        return '#';
 
-    }
-    
-    int getRows() {
+class BucketQueue {
 
-         return rows;
+    // PURPOSE: Monotone priority queue for small integer edge weights (Dial's algorithm)
+    // With weights at most maxWeight, every queued distance lies within
+    // maxWeight of the last one popped, so maxWeight + 1 circular buckets
+    // are enough. Buckets are intrusive doubly linked lists over node ids,
+    // so moving a node to a lower bucket is O(1).
+    // USED IN: Dijkstra search
 
-         }
+private:
 
-    int getCols() { 
+    int* head;          // First node of each bucket, -1 if empty
+    int* next;
+    int* prev;
+    int* bucketOf;      // Bucket holding each node, -1 when not queued
+    int bucketCount;
+    int size;
+    long long current;  // Distance of the last bucket popped from
+
+    void unlink(int node) {
+
+        int b = bucketOf[node];
+        if (prev[node] != -1) next[prev[node]] = next[node];
+        else head[b] = next[node];
+        if (next[node] != -1) prev[next[node]] = prev[node];
+        bucketOf[node] = -1;
+        size--;
 
-        return cols;
+    }
 
-     }
+public:
 
-    int getStartRow() {
+    BucketQueue(int nodeCapacity, int maxWeight) : bucketCount(maxWeight + 1), size(0), current(0) {
+        if (nodeCapacity < 1) nodeCapacity = 1;
+        head = new int[bucketCount];
+        next = new int[nodeCapacity];
+        prev = new int[nodeCapacity];
+        bucketOf = new int[nodeCapacity];
+        for (int b = 0; b < bucketCount; b++) head[b] = -1;
+        for (int i = 0; i < nodeCapacity; i++) bucketOf[i] = -1;
+    }
 
-         return startRow;
+    bool isEmpty() {
 
-         }
+        return size == 0;
 
-    int getStartCol() {
+    }
 
-         return startCol;
+    void push(int node, long long dist) {
 
-         }
+        // Insert node at dist, moving it if it is already queued
+        if (bucketOf[node] != -1) unlink(node);
+        int b = (int)(dist % bucketCount);
+        prev[node] = -1;
+        next[node] = head[b];
+        if (head[b] != -1) prev[head[b]] = node;
+        head[b] = node;
+        bucketOf[node] = b;
+        size++;
 
-    int getEndRow() {
+    }
 
-         return endRow;
+    int popMin(long long& dist) {
 
-         }
+        // Remove a node with the smallest distance; dist receives that distance
+        if (size == 0) return -1;
+        while (head[current % bucketCount] == -1) current++;
+        int node = head[current % bucketCount];
+        unlink(node);
+        dist = current;
+        return node;
 
-    int getEndCol() { 
+    }
 
-        return endCol;
+    ~BucketQueue() {
 
-     }
+        delete[] head;
+        delete[] next;
+        delete[] prev;
+        delete[] bucketOf;
 
+    }
+};
+
+
+// ==================== THREAD POOL ====================
+// PURPOSE: Fixed set of worker threads that all run the same job together
+// run(job) calls job(threadId) once on every thread, with the calling thread
+// acting as thread 0, and returns when all of them have finished.
+// USED IN: Parallel BFS
+
+class ThreadPool {
+
+private:
+
+    thread* workers;
+    int threadCount;
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    function<void(int)> job;
+    long long generation;    // Bumped once per run() so workers can tell runs apart
+    int pending;             // Workers still running the current job
+    bool stopping;
+
+    void workerLoop(int id) {
+
+        long long seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> guard(lock);
+                while (!stopping && generation == seen) wake.wait(guard);
+                if (stopping) return;
+                seen = generation;
+            }
+
+            job(id);
+
+            {
+                unique_lock<mutex> guard(lock);
+                pending--;
+                if (pending == 0) done.notify_one();
+            }
+        }
+
+    }
+
+public:
+
+    ThreadPool(int threads) : threadCount(threads > 0 ? threads : 1), generation(0), pending(0), stopping(false) {
+        workers = new thread[threadCount];
+        for (int i = 1; i < threadCount; i++) {
+            workers[i] = thread(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    int getThreadCount() {
+
+        return threadCount;
+
+    }
+
+    void run(const function<void(int)>& task) {
+
+        if (threadCount == 1) {
+            task(0);
+            return;
+        }
+
+        {
+            unique_lock<mutex> guard(lock);
+            job = task;
+            pending = threadCount - 1;
+            generation++;
+        }
+        wake.notify_all();
+
+        task(0);
+
+        unique_lock<mutex> guard(lock);
+        while (pending > 0) done.wait(guard);
+
+    }
+
+    ~ThreadPool() {
+
+        {
+            unique_lock<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (int i = 1; i < threadCount; i++) {
+            workers[i].join();
+        }
+        delete[] workers;
+
+    }
+};
+
+int defaultThreadCount() {
+
+    unsigned int hardware = thread::hardware_concurrency();
+    return hardware > 0 ? (int)hardware : 1;
+
+}
+
+
+// ==================== BIT HELPERS ====================
+// PURPOSE: Word-level bit counting shared by the bitmap code
+// USED IN: CoordIndex, text scanning, bit-parallel BFS
+
+inline int popCount64(unsigned long long x) {
+
+    // PURPOSE: Number of set bits
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    while (x) {
+        x &= x - 1;
+        count++;
+    }
+    return count;
+#endif
+
+}
+
+inline int trailingZeros64(unsigned long long x) {
+
+    // PURPOSE: Index of the lowest set bit (x must not be 0)
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+
+}
+
+// ==================== HASH MAP FOR COORDINATES ====================
+// PURPOSE: Fast lookup of node ID from maze coordinates (row, col)
+// USED IN: Converting maze grid positions to graph node IDs in O(1) time
+// HashMap chains entries per bucket; OpenHashMap below keeps them in one
+// flat array, and CoordIndex (what MazeSolver uses) picks between a dense
+// per-cell array and OpenHashMap. --bench-hash compares all three.
+
+int nextPrime(int n) {
+
+    // PURPOSE: Smallest prime >= n (used to size hash tables)
+    if (n <= 2) return 2;
+    if (n % 2 == 0) n++;
+    while (true) {
+        bool prime = true;
+        for (int d = 3; (long long)d * d <= n; d += 2) {
+            if (n % d == 0) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) return n;
+        n += 2;
+    }
+
+}
+
+class HashMap {
+
+private:
+
+    int tableSize;  // Prime number for better distribution, sized from expected entries
+
+    struct Entry {
+        // PURPOSE: Store coordinate-to-nodeID mapping
+        int row, col, nodeId;
+        Entry* next;  // For collision handling (chaining)
+        Entry(int r, int c, int id) : row(r), col(c), nodeId(id), next(NULL) {}
+
+    };
+    Entry** table;
+    NodePool<Entry> entryPool;   // Entries are only freed together, with the map
+    
+    int hash(int row, int col) {
+
+        // PURPOSE: Convert (row, col) to array index
+        // Multiplier is larger than any column count, so distinct cells get distinct keys
+        return (int)(((long long)row * 1000003LL + col) % tableSize);
+
+    }
+    
+public:
+    HashMap(int expectedEntries = 1009) {
+
+        tableSize = nextPrime(expectedEntries > 1009 ? expectedEntries : 1009);
+        table = new Entry*[tableSize];
+        for (int i = 0; i < tableSize; i++) {
+            table[i] = NULL;
+
+        }
+    }
+    
+    void insert(int row, int col, int nodeId) {
+
+        // PURPOSE: Store mapping (row, col) -> nodeId
+        int idx = hash(row, col);
+        Entry* newEntry = entryPool.create(row, col, nodeId);
+        newEntry->next = table[idx];
+        table[idx] = newEntry;
+
+    }
+    
+    int get(int row, int col) {
+
+        // PURPOSE: Retrieve nodeId for given (row, col)
+        if (row < 0 || col < 0) return -1;
+        int idx = hash(row, col);
+        Entry* curr = table[idx];
+        while (curr != NULL) {
+            if (curr->row == row && curr->col == col) {
+                return curr->nodeId;
+            }
+            curr = curr->next;
+        }
+        return -1;  // Not found
+
+    }
+    
+    ~HashMap() {
+
+        // Cleanup: entryPool frees all entries with its slabs
+        delete[] table;
+    }
+
+};
+
+class OpenHashMap {
+
+    // PURPOSE: Coordinate map with open addressing (linear probing)
+    // Keys and values sit side by side in one flat array, so a lookup is
+    // usually a single cache line. The table is a power of two kept at most
+    // half full, and grows by rehashing when it would pass that.
+
+private:
+
+    struct Slot {
+        unsigned long long key;    // (row << 32) | col, EMPTY_KEY when unused
+        int nodeId;
+    };
+
+    static const unsigned long long EMPTY_KEY = ~0ULL;
+
+    Slot* slots;
+    int capacity;     // Power of two
+    int mask;
+    int count;
+
+    static unsigned long long makeKey(int row, int col) {
+
+        return ((unsigned long long)(unsigned int)row << 32) | (unsigned int)col;
+
+    }
+
+    int slotOf(unsigned long long key) {
+
+        // PURPOSE: Home slot of a key, spread over the whole table
+        // (splitmix64 finalizer: every input bit affects every output bit).
+        // Keeping columns adjacent instead would make whole rows collide.
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return (int)(key & (unsigned long long)mask);
+
+    }
+
+    void allocate(int newCapacity) {
+
+        capacity = newCapacity;
+        mask = capacity - 1;
+        slots = new Slot[capacity];
+        for (int i = 0; i < capacity; i++) slots[i].key = EMPTY_KEY;
+
+    }
+
+    void grow() {
+
+        // Rehash every entry into a table twice the size
+        Slot* old = slots;
+        int oldCapacity = capacity;
+        allocate(capacity * 2);
+        count = 0;
+        for (int i = 0; i < oldCapacity; i++) {
+            if (old[i].key != EMPTY_KEY) place(old[i].key, old[i].nodeId);
+        }
+        delete[] old;
+
+    }
+
+    void place(unsigned long long key, int nodeId) {
+
+        int idx = slotOf(key);
+        while (slots[idx].key != EMPTY_KEY) {
+            if (slots[idx].key == key) {
+                slots[idx].nodeId = nodeId;
+                return;
+            }
+            idx = (idx + 1) & mask;
+        }
+        slots[idx].key = key;
+        slots[idx].nodeId = nodeId;
+        count++;
+
+    }
+
+public:
+
+    OpenHashMap(int expectedEntries = 1024) : count(0) {
+
+        // Start at least twice the expected size so no rehash is needed
+        int initial = 16;
+        while (initial < expectedEntries * 2 && initial < (1 << 30)) initial *= 2;
+        allocate(initial);
+
+    }
+
+    void insert(int row, int col, int nodeId) {
+
+        // PURPOSE: Store mapping (row, col) -> nodeId, replacing an existing one
+        if ((count + 1) * 2 > capacity) grow();
+        place(makeKey(row, col), nodeId);
+
+    }
+
+    int get(int row, int col) {
+
+        // PURPOSE: Retrieve nodeId for given (row, col), or -1
+        if (row < 0 || col < 0) return -1;
+        unsigned long long key = makeKey(row, col);
+        int idx = slotOf(key);
+        while (true) {
+            unsigned long long stored = slots[idx].key;
+            if (stored == key) return slots[idx].nodeId;
+            if (stored == EMPTY_KEY) return -1;
+            idx = (idx + 1) & mask;
+        }
+
+    }
+
+    int getCount() {
+
+        return count;
+
+    }
+
+    ~OpenHashMap() {
+
+        delete[] slots;
+
+    }
+};
+
+class CoordIndex {
+
+    // PURPOSE: Cell -> node id map used by MazeSolver
+    // A maze is a grid, so a dense array indexed by row * cols + col answers
+    // every lookup with one load. It costs 4 bytes per cell, while a hash
+    // entry costs 32 bytes per open cell (16-byte slot, table half full), so
+    // mazes that are mostly wall use an OpenHashMap instead.
+    // When node ids are the open cells numbered in row-major order (as in a
+    // graph stored in a binary maze file), the id is just the number of open
+    // cells before (row, col): a count per 64-cell word plus one popcount.
+
+private:
+
+    int rows, cols;
+    int* dense;            // NULL when sparse is used
+    OpenHashMap* sparse;
+    const unsigned long long* rankBits;   // Walkability bits, in rank mode
+    int* wordRank;                        // Open cells before each word, in rank mode
+    int rowWords;
+    int rankedCount;                      // Open cells in total, in rank mode
+
+public:
+
+    CoordIndex(int r, int c, int openCells) : rows(r), cols(c), dense(NULL), sparse(NULL),
+        rankBits(NULL), wordRank(NULL), rowWords(0), rankedCount(0) {
+        long long cells = (long long)rows * cols;
+        if (cells <= (long long)openCells * 8) {
+            dense = new int[cells > 0 ? cells : 1];
+            for (long long i = 0; i < cells; i++) dense[i] = -1;
+        } else {
+            sparse = new OpenHashMap(openCells);
+        }
+    }
+
+    // Rank mode over a maze's walkability bits (Maze layout, see MAZE CLASS)
+    CoordIndex(int r, int c, const unsigned long long* openBits, int words) : rows(r), cols(c),
+        dense(NULL), sparse(NULL), rankBits(openBits), rowWords(words) {
+        long long total = (long long)rows * rowWords;
+        wordRank = new int[total > 0 ? total : 1];
+        int count = 0;
+        for (long long w = 0; w < total; w++) {
+            wordRank[w] = count;
+            count += popCount64(rankBits[w]);
+        }
+        rankedCount = count;
+    }
+
+    bool isDense() {
+
+        return dense != NULL;
+
+    }
+
+    int getRankedCount() {
+
+        return rankedCount;
+
+    }
+
+    void insert(int row, int col, int nodeId) {
+
+        // Rank mode derives ids from the bits, so there is nothing to store
+        if (dense != NULL) dense[(long long)row * cols + col] = nodeId;
+        else if (sparse != NULL) sparse->insert(row, col, nodeId);
+
+    }
+
+    int get(int row, int col) {
+
+        // PURPOSE: Node id of (row, col), or -1 for walls and out-of-range cells
+        if (row < 0 || row >= rows || col < 0 || col >= cols) return -1;
+        if (dense != NULL) return dense[(long long)row * cols + col];
+        if (sparse != NULL) return sparse->get(row, col);
+
+        long long w = (long long)row * rowWords + (col >> 6);
+        unsigned long long bits = rankBits[w];
+        if (!((bits >> (col & 63)) & 1)) return -1;
+        return wordRank[w] + popCount64(bits & ((1ULL << (col & 63)) - 1));
+
+    }
+
+    ~CoordIndex() {
+
+        delete[] dense;
+        delete sparse;
+        delete[] wordRank;
+
+    }
+};
+
+// ==================== GRAPH CLASS ====================
+class Graph {
+
+private:
+    AdjListNode** adjList;
+    int nodeCount;
+    int capacity;
+    int* nodeRows;
+    int* nodeCols;
+    NodePool<AdjListNode> edgePool;   // All edges, freed together with the graph
+    
+public:
+
+    Graph(int maxNodes) : nodeCount(0), capacity(maxNodes) {
+        adjList = new AdjListNode*[capacity];
+        nodeRows = new int[capacity];
+        nodeCols = new int[capacity];
+        for (int i = 0; i < capacity; i++) {
+            adjList[i] = NULL;
+        }
+    }
+    
+    int addNode(int row, int col) {
+
+        if (nodeCount >= capacity) return -1;
+
+        int id = nodeCount;
+        nodeRows[id] = row;
+        nodeCols[id] = col;
+        nodeCount++;
+        return id;
+
+    }
+    
+    void addEdge(int src, int dest, int weight) {
+
+        AdjListNode* newNode = edgePool.create(dest, weight);
+        newNode->next = adjList[src];
+        adjList[src] = newNode;
+
+    }
+    
+    int getNodeCount() { 
+
+        return nodeCount;
+
+     }
+    
+    AdjListNode* getAdjList(int node) {
+
+         return adjList[node]; 
+
+        }
+    
+    void getNodeCoords(int node, int& row, int& col) {
+
+        row = nodeRows[node];
+        col = nodeCols[node];
+
+    }
+    
+    ~Graph() {
+
+        // Edges are released in bulk by edgePool
+        delete[] adjList;
+        delete[] nodeRows;
+        delete[] nodeCols;
+    }
+};
+
+// ==================== CSR GRAPH CLASS ====================
+// PURPOSE: Same graph as above in Compressed Sparse Row form
+// Edges of node u are dests[offsets[u] .. offsets[u+1]-1], stored contiguously,
+// so neighbor iteration streams through memory instead of chasing pointers
+// USED IN: All MazeSolver searches
+
+class CSRGraph {
+
+private:
+    int nodeCount, edgeCount;
+    int nodeCapacity, edgeCapacity;
+    int* offsets;     // nodeCapacity + 1 entries
+    int* dests;       // Destination node of each edge
+    int* weights;     // Weight of each edge
+    int* nodeRows;
+    int* nodeCols;
+    int lastSrc;      // Highest source node whose edges have been added
+    bool ownsArrays;  // False for a view of arrays stored elsewhere
+
+public:
+
+    CSRGraph(int maxNodes, int maxEdges) : nodeCount(0), edgeCount(0),
+        nodeCapacity(maxNodes), edgeCapacity(maxEdges), lastSrc(-1), ownsArrays(true) {
+        offsets = new int[nodeCapacity + 1];
+        dests = new int[edgeCapacity > 0 ? edgeCapacity : 1];
+        weights = new int[edgeCapacity > 0 ? edgeCapacity : 1];
+        nodeRows = new int[nodeCapacity > 0 ? nodeCapacity : 1];
+        nodeCols = new int[nodeCapacity > 0 ? nodeCapacity : 1];
+        offsets[0] = 0;
+    }
+
+    // Read-only view of a finished graph whose arrays live elsewhere
+    // (a memory-mapped binary maze file); nothing is copied or freed
+    CSRGraph(int nodes, int edges, const int* offsetArray, const int* destArray, const int* weightArray,
+             const int* rowArray, const int* colArray) : nodeCount(nodes), edgeCount(edges),
+        nodeCapacity(nodes), edgeCapacity(edges), offsets((int*)offsetArray), dests((int*)destArray),
+        weights((int*)weightArray), nodeRows((int*)rowArray), nodeCols((int*)colArray),
+        lastSrc(nodes), ownsArrays(false) {}
+
+    int addNode(int row, int col) {
+
+        if (nodeCount >= nodeCapacity) return -1;
+
+        int id = nodeCount;
+        nodeRows[id] = row;
+        nodeCols[id] = col;
+        nodeCount++;
+        return id;
+
+    }
+
+    void addEdge(int src, int dest, int weight) {
+
+        // Edges must be added grouped by source, in increasing source order
+        if (edgeCount >= edgeCapacity || src < lastSrc) return;
+
+        while (lastSrc < src) {
+            lastSrc++;
+            offsets[lastSrc] = edgeCount;
+        }
+        dests[edgeCount] = dest;
+        weights[edgeCount] = weight;
+        edgeCount++;
+
+    }
+
+    void finalize() {
+
+        // Close the offset ranges of the remaining nodes
+        if (!ownsArrays) return;
+        while (lastSrc < nodeCount) {
+            lastSrc++;
+            offsets[lastSrc] = edgeCount;
+        }
+
+    }
+
+    int getNodeCount() {
+
+        return nodeCount;
+
+    }
+
+    int getEdgeCount() {
+
+        return edgeCount;
+
+    }
+
+    int getEdgeBegin(int node) {
+
+        return offsets[node];
+
+    }
+
+    int getEdgeEnd(int node) {
+
+        return offsets[node + 1];
+
+    }
+
+    int getEdgeDest(int edge) {
+
+        return dests[edge];
+
+    }
+
+    int getEdgeWeight(int edge) {
+
+        return weights[edge];
+
+    }
+
+    void getNodeCoords(int node, int& row, int& col) {
+
+        row = nodeRows[node];
+        col = nodeCols[node];
+
+    }
+
+    const int* getOffsets() {
+
+        return offsets;
+
+    }
+
+    const int* getDests() {
+
+        return dests;
+
+    }
+
+    const int* getWeights() {
+
+        return weights;
+
+    }
+
+    const int* getNodeRows() {
+
+        return nodeRows;
+
+    }
+
+    const int* getNodeCols() {
+
+        return nodeCols;
+
+    }
+
+    ~CSRGraph() {
+
+        if (!ownsArrays) return;
+        delete[] offsets;
+        delete[] dests;
+        delete[] weights;
+        delete[] nodeRows;
+        delete[] nodeCols;
+
+    }
+};
+
+// ==================== FILE MAPPING ====================
+// PURPOSE: Read-only view of a whole file without copying it
+// The file is memory-mapped, so pages are read in by the OS as they are
+// touched. If mapping fails (e.g. special files) it is read into a buffer.
+// USED IN: Maze::loadFromFile
+
+class MappedFile {
+
+private:
+
+    const char* data;
+    long long size;
+    bool mapped;         // data is a mapping (else a heap buffer or NULL)
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+
+    bool readIntoBuffer(const char* filename) {
+
+        ifstream file(filename, ios::binary);
+        if (!file.is_open()) return false;
+        file.seekg(0, ios::end);
+        size = (long long)file.tellg();
+        file.seekg(0, ios::beg);
+        if (size < 0) return false;
+        char* buffer = new char[size > 0 ? size : 1];
+        file.read(buffer, size);
+        data = buffer;
+        return true;
+
+    }
+
+public:
+
+    MappedFile() : data(NULL), size(0), mapped(false) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+        mappingHandle = NULL;
+#endif
+    }
+
+    bool open(const char* filename) {
+
+#ifdef _WIN32
+        fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0) {
+            mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mappingHandle != NULL) {
+                data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+                if (data != NULL) {
+                    size = fileSize.QuadPart;
+                    mapped = true;
+                    return true;
+                }
+            }
+        }
+#else
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+                madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+#endif
+                data = (const char*)view;
+                size = (long long)info.st_size;
+                mapped = true;
+                ::close(fd);
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+        return readIntoBuffer(filename);
+
+    }
+
+    const char* getData() {
+
+        return data;
+
+    }
+
+    long long getSize() {
+
+        return size;
+
+    }
+
+    bool isMapped() {
+
+        return mapped;
+
+    }
+
+    ~MappedFile() {
+
+        if (mapped) {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+#else
+            munmap((void*)data, (size_t)size);
+#endif
+        } else {
+            delete[] data;
+        }
+#ifdef _WIN32
+        if (mappingHandle != NULL) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+#endif
+
+    }
+};
+
+// ==================== TEXT SCANNING ====================
+// PURPOSE: Vectorized helpers for parsing maze text
+// Each call looks at 64 bytes and returns one bit per byte, using AVX2
+// (2 x 32 bytes) or SSE2 (4 x 16 bytes) compares when available and a
+// plain loop otherwise. Callers must make sure all 64 bytes are readable.
+// USED IN: Maze::parseBuffer
+
+inline unsigned long long newlineMask64(const char* p) {
+
+    // PURPOSE: Bit i set when p[i] is '\n'
+#if defined(__AVX2__)
+    __m256i nl = _mm256_set1_epi8('\n');
+    unsigned int lo = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), nl));
+    unsigned int hi = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + 32)), nl));
+    return ((unsigned long long)hi << 32) | lo;
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128i nl = _mm_set1_epi8('\n');
+    unsigned long long mask = 0;
+    for (int k = 0; k < 4; k++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(p + 16 * k));
+        mask |= (unsigned long long)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, nl)) << (16 * k);
+    }
+    return mask;
+#else
+    unsigned long long mask = 0;
+    for (int i = 0; i < 64; i++) {
+        if (p[i] == '\n') mask |= 1ULL << i;
+    }
+    return mask;
+#endif
+
+}
+
+inline unsigned long long classifyCells64(const char* p, unsigned long long& special) {
+
+    // PURPOSE: Bit i set when p[i] is an open cell (' ', 'S', 'E' or '1'-'9');
+    // special gets the bits of 'S', 'E' and digits, which need a closer look.
+    // Digits are found with one signed compare: adding 0x4F maps '1'..'9'
+    // to -128..-120 and every other byte above that.
+#if defined(__AVX2__)
+    unsigned long long open = 0;
+    special = 0;
+    for (int k = 0; k < 2; k++) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(p + 32 * k));
+        __m256i mark = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('S')),
+                                       _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('E')));
+        __m256i digit = _mm256_cmpgt_epi8(_mm256_set1_epi8(-119), _mm256_add_epi8(bytes, _mm256_set1_epi8(0x4F)));
+        mark = _mm256_or_si256(mark, digit);
+        __m256i space = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+        special |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(mark) << (32 * k);
+        open |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(_mm256_or_si256(mark, space)) << (32 * k);
+    }
+    return open;
+#elif defined(__SSE2__) || defined(_M_X64)
+    unsigned long long open = 0;
+    special = 0;
+    for (int k = 0; k < 4; k++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(p + 16 * k));
+        __m128i mark = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('S')),
+                                    _mm_cmpeq_epi8(bytes, _mm_set1_epi8('E')));
+        __m128i digit = _mm_cmplt_epi8(_mm_add_epi8(bytes, _mm_set1_epi8(0x4F)), _mm_set1_epi8(-119));
+        mark = _mm_or_si128(mark, digit);
+        __m128i space = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+        special |= (unsigned long long)(unsigned int)_mm_movemask_epi8(mark) << (16 * k);
+        open |= (unsigned long long)(unsigned int)_mm_movemask_epi8(_mm_or_si128(mark, space)) << (16 * k);
+    }
+    return open;
+#else
+    unsigned long long open = 0;
+    special = 0;
+    for (int i = 0; i < 64; i++) {
+        char c = p[i];
+        bool mark = (c == 'S' || c == 'E' || (c >= '1' && c <= '9'));
+        if (mark) special |= 1ULL << i;
+        if (mark || c == ' ') open |= 1ULL << i;
+    }
+    return open;
+#endif
+
+}
+
+// ==================== BINARY MAZE FORMAT ====================
+// PURPOSE: On-disk layout that a Maze can use straight from a memory map
+// A fixed header is followed by sections at 64-byte aligned offsets:
+//   bits   - the walkability words exactly as Maze keeps them
+//            (rows * rowWords words plus one zero word of padding)
+//   costs  - rows * cols cell digits, if the maze has any (0 where there is
+//            none, which costs 1 like a digit '1')
+//   graph  - the CSR graph MazeSolver would build: offsets (nodes + 1),
+//            dests, weights (edges each), node rows, node cols (nodes each)
+//   components - run counts per word (rows * rowWords), the component of
+//            each run, then the size of each component (see COMPONENT LABELS)
+//   landmarks - the landmark node ids, then the node-major distance table
+//            (see LANDMARKS), with nodes numbered as the graph section
+//   exits  - row * cols + col of every E cell, if there is more than one
+//            (the header's end cell is the last of them)
+// Numbers are in the writing machine's byte order; a file from a machine
+// with the other order fails the version check. Written by --convert.
+// USED IN: Maze::loadFromFile, writeBinaryMaze
+
+const char MAZE_FILE_MAGIC[8] = {'M', 'A', 'Z', 'E', 'B', 'I', 'N', '\0'};
+const unsigned int MAZE_FILE_VERSION = 2;
+const unsigned int MAZE_FILE_HAS_COSTS = 1;
+const unsigned int MAZE_FILE_HAS_GRAPH = 2;
+const unsigned int MAZE_FILE_HAS_COMPONENTS = 4;
+const unsigned int MAZE_FILE_HAS_LANDMARKS = 8;
+const unsigned int MAZE_FILE_HAS_EXITS = 16;
+const long long MAZE_FILE_ALIGN = 64;
+
+struct MazeFileHeader {
+    char magic[8];
+    unsigned int version;
+    unsigned int flags;        // MAZE_FILE_HAS_* bits
+    int rows, cols;
+    int rowWords;
+    int startRow, startCol;
+    int endRow, endCol;
+    int maxCost;
+    int nodeCount, edgeCount;  // 0 without a graph section
+    long long bitsOffset;
+    long long costsOffset;     // 0 without a costs section
+    long long graphOffset;     // 0 without a graph section
+    long long fileSize;
+    long long componentsOffset;   // 0 without a components section
+    int runCount;
+    int componentCount;
+    long long landmarksOffset;    // 0 without a landmarks section
+    int landmarkCount;
+    int landmarkNodeCount;
+    long long exitsOffset;        // 0 without an exits section
+    int exitCount;
+};
+
+long long alignFileOffset(long long offset) {
+
+    return (offset + MAZE_FILE_ALIGN - 1) / MAZE_FILE_ALIGN * MAZE_FILE_ALIGN;
+
+}
+
+bool isBinaryMaze(const char* data, long long len) {
+
+    return len >= (long long)sizeof(MazeFileHeader) && memcmp(data, MAZE_FILE_MAGIC, 8) == 0;
+
+}
+
+// ==================== DISJOINT SET ====================
+// PURPOSE: Union-find over ids 0 .. n-1
+// Union by rank keeps trees shallow and find() halves paths as it walks,
+// so any sequence of operations runs in near-constant amortized time.
+// A root stores -(rank + 1) in place of a parent, so each step of find()
+// touches a single array.
+// USED IN: Component labels, Kruskal maze generator
+
+class DisjointSet {
+
+private:
+
+    int* parent;
+    int count;
+    int sets;
+
+public:
+
+    DisjointSet(int n) : count(n > 0 ? n : 0), sets(n > 0 ? n : 0) {
+        parent = new int[count > 0 ? count : 1];
+        for (int i = 0; i < count; i++) parent[i] = -1;
+    }
+
+    int find(int x) {
+
+        // PURPOSE: Representative of x's set
+        while (parent[x] >= 0) {
+            int up = parent[x];
+            if (parent[up] >= 0) parent[x] = parent[up];
+            x = up;
+        }
+        return x;
+
+    }
+
+    bool unite(int a, int b) {
+
+        // PURPOSE: Merge the sets of a and b; false if they were already one set
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (parent[a] > parent[b]) {     // a has the lower rank
+            int temp = a;
+            a = b;
+            b = temp;
+        }
+        if (parent[a] == parent[b]) parent[a]--;
+        parent[b] = a;
+        sets--;
+        return true;
+
+    }
+
+    int getSetCount() {
+
+        return sets;
+
+    }
+
+    void prefetch(int x) {
+
+        // PURPOSE: Hint that x will be looked up soon
+#if defined(__GNUC__)
+        __builtin_prefetch(&parent[x]);
+#else
+        (void)x;
+#endif
+
+    }
+
+    ~DisjointSet() {
+
+        delete[] parent;
+
+    }
+};
+
+// ==================== COMPONENT LABELS ====================
+// PURPOSE: Which connected region of open cells each cell belongs to
+// Computed once per maze. Each horizontal run of open cells is one
+// DisjointSet entry, runs that touch vertically are united, and the sets are
+// numbered 0, 1, ... in row-major order of first appearance. Two cells are
+// connected exactly when their labels match, so an unreachable query is
+// rejected without a search that floods the whole start region.
+// Labels are kept per run, not per cell: the run holding a cell is found
+// like CoordIndex's rank mode, from a run count per 64-cell word plus a
+// popcount of the run starts, which are computed from the walkability bits.
+// USED IN: Maze::getComponents (searches, batch queries, binary maze files)
+
+class ComponentLabels {
+
+private:
+
+    const unsigned long long* openBits;   // The maze's walkability bits (not owned)
+    int rows, cols, rowWords;
+    int* runRank;        // Runs starting before each word (rows * rowWords entries)
+    int* runLabels;      // Component of each run
+    int* sizes;          // Open cells per component
+    int runCount;
+    int componentCount;
+    bool ownsArrays;     // False for arrays stored in a mapped binary maze file
+
+    unsigned long long runStarts(long long word, int wordInRow) {
+
+        // PURPOSE: Bits of word where a run of open cells begins
+        unsigned long long bits = openBits[word];
+        unsigned long long carry = wordInRow > 0 ? openBits[word - 1] >> 63 : 0;
+        return bits & ~((bits << 1) | carry);
+
+    }
+
+    int runAt(long long word, int wordInRow, int bit) {
+
+        // PURPOSE: Run holding the open cell at bit of word
+        unsigned long long upTo = (2ULL << bit) - 1;   // Bits 0 .. bit (all 64 when bit is 63)
+        return runRank[word] + popCount64(runStarts(word, wordInRow) & upTo) - 1;
+
+    }
+
+public:
+
+    ComponentLabels(const unsigned long long* bits, int r, int c, int words) : openBits(bits), rows(r), cols(c),
+        rowWords(words), runCount(0), componentCount(0), ownsArrays(true) {
+
+        long long totalWords = (long long)rows * rowWords;
+        runRank = new int[totalWords > 0 ? totalWords : 1];
+        for (int i = 0; i < rows; i++) {
+            for (int k = 0; k < rowWords; k++) {
+                long long w = (long long)i * rowWords + k;
+                runRank[w] = runCount;
+                runCount += popCount64(runStarts(w, k));
+            }
+        }
+
+        // Unite runs that touch vertically: once per stretch of columns where
+        // both rows are open and neither row starts a new run
+        DisjointSet sets(runCount);
+        for (int i = 0; i + 1 < rows; i++) {
+            unsigned long long carry = 0;
+            for (int k = 0; k < rowWords; k++) {
+                long long above = (long long)i * rowWords + k;
+                long long below = above + rowWords;
+                unsigned long long both = openBits[above] & openBits[below];
+                unsigned long long contacts = (both & ~((both << 1) | carry)) |
+                                              (both & (runStarts(above, k) | runStarts(below, k)));
+                carry = both >> 63;
+                while (contacts != 0) {
+                    int bit = trailingZeros64(contacts);
+                    sets.unite(runAt(above, k, bit), runAt(below, k, bit));
+                    contacts &= contacts - 1;
+                }
+            }
+        }
+
+        // A root gets its label as soon as any of its runs is seen, so when
+        // the scan reaches the root itself the label is already there
+        runLabels = new int[runCount > 0 ? runCount : 1];
+        for (int run = 0; run < runCount; run++) runLabels[run] = -1;
+        for (int run = 0; run < runCount; run++) {
+            int root = sets.find(run);
+            if (runLabels[root] == -1) runLabels[root] = componentCount++;
+            runLabels[run] = runLabels[root];
+        }
+
+        // Component sizes, one stretch of consecutive open bits at a time
+        sizes = new int[componentCount > 0 ? componentCount : 1]();
+        for (int i = 0; i < rows; i++) {
+            for (int k = 0; k < rowWords; k++) {
+                long long w = (long long)i * rowWords + k;
+                unsigned long long open = openBits[w];
+                while (open != 0) {
+                    int bit = trailingZeros64(open);
+                    unsigned long long rest = ~(open >> bit);
+                    int length = rest == 0 ? 64 - bit : trailingZeros64(rest);
+                    sizes[runLabels[runAt(w, k, bit)]] += length;
+                    open &= length + bit >= 64 ? 0 : ~0ULL << (length + bit);
+                }
+            }
+        }
+
+    }
+
+    // View of arrays kept elsewhere (a mapped binary maze file)
+    ComponentLabels(const unsigned long long* bits, int r, int c, int words, int runs, int components,
+                    const int* rankArray, const int* labelArray, const int* sizeArray) : openBits(bits),
+        rows(r), cols(c), rowWords(words), runRank((int*)rankArray), runLabels((int*)labelArray),
+        sizes((int*)sizeArray), runCount(runs), componentCount(components), ownsArrays(false) {}
+
+    int getLabel(int row, int col) {
+
+        // PURPOSE: Component of (row, col), or -1 for walls and out-of-range cells
+        if (row < 0 || row >= rows || col < 0 || col >= cols) return -1;
+        long long w = (long long)row * rowWords + (col >> 6);
+        if (!((openBits[w] >> (col & 63)) & 1)) return -1;
+        return runLabels[runAt(w, col >> 6, col & 63)];
+
+    }
+
+    bool connected(int r1, int c1, int r2, int c2) {
+
+        // PURPOSE: True when both cells are open and a path joins them
+        int label = getLabel(r1, c1);
+        return label != -1 && label == getLabel(r2, c2);
+
+    }
+
+    int getComponentCount() {
+
+        return componentCount;
+
+    }
+
+    int getComponentSize(int label) {
+
+        return sizes[label];
+
+    }
+
+    int getRunCount() {
+
+        return runCount;
+
+    }
+
+    const int* getRunRanks() {
+
+        return runRank;
+
+    }
+
+    const int* getRunLabels() {
+
+        return runLabels;
+
+    }
+
+    const int* getSizes() {
+
+        return sizes;
+
+    }
+
+    ~ComponentLabels() {
+
+        if (!ownsArrays) return;
+        delete[] runRank;
+        delete[] runLabels;
+        delete[] sizes;
+
+    }
+};
+
+// ==================== LANDMARKS ====================
+// PURPOSE: Distance tables for A* with landmark lower bounds (ALT)
+// For a landmark L and any nodes v, t the triangle inequality gives
+// dist(v, t) >= |dist(L, t) - dist(L, v)|. With distances from a few
+// landmarks spread around the maze this bound is far tighter than Manhattan
+// distance, which ignores walls. Distances are BFS step counts; every step
+// costs at least 1, so the bound also holds for weighted cells, and it changes
+// by at most 1 per step, so A* with it stays consistent.
+// The table is node-major (the distances of one node are adjacent), so one
+// heuristic evaluation reads one cache line. -1 marks a node the landmark
+// cannot reach, which gives no bound.
+// USED IN: MazeSolver::buildLandmarks, A* (Landmarks), binary maze files
+
+const int DEFAULT_LANDMARK_COUNT = 8;
+
+class LandmarkTable {
+
+private:
+
+    int count;           // Landmarks per node
+    int nodeCount;
+    int* landmarks;      // Node id of each landmark
+    int* dist;           // dist[node * count + i]: steps from landmark i to node
+    bool ownsArrays;     // False for arrays stored in a mapped binary maze file
+
+public:
+
+    LandmarkTable(int landmarkCount, int nodes) : count(landmarkCount), nodeCount(nodes), ownsArrays(true) {
+        landmarks = new int[count > 0 ? count : 1];
+        long long entries = (long long)nodeCount * count;
+        dist = new int[entries > 0 ? entries : 1];
+    }
+
+    // View of tables already in memory (a mapped binary maze file)
+    LandmarkTable(int landmarkCount, int nodes, const int* landmarkNodes, const int* distances) :
+        count(landmarkCount), nodeCount(nodes), landmarks((int*)landmarkNodes), dist((int*)distances),
+        ownsArrays(false) {}
+
+    const int* getDistances(int node) {
+
+        return dist + (long long)node * count;
+
+    }
+
+    // Largest landmark bound on the steps between the nodes owning the two rows
+    int lowerBound(const int* from, const int* to) {
+
+        int best = 0;
+        for (int i = 0; i < count; i++) {
+            if (from[i] < 0 || to[i] < 0) continue;
+            int d = from[i] > to[i] ? from[i] - to[i] : to[i] - from[i];
+            if (d > best) best = d;
+        }
+        return best;
+
+    }
+
+    void setLandmark(int i, int node) {
+
+        landmarks[i] = node;
+
+    }
+
+    void setDistance(int node, int i, int d) {
+
+        dist[(long long)node * count + i] = d;
+
+    }
+
+    int getCount() {
+
+        return count;
+
+    }
+
+    int getNodeCount() {
+
+        return nodeCount;
+
+    }
+
+    int getLandmark(int i) {
+
+        return landmarks[i];
+
+    }
+
+    const int* getLandmarks() {
+
+        return landmarks;
+
+    }
+
+    const int* getTable() {
+
+        return dist;
+
+    }
+
+    long long getBytesPerLandmark() {
+
+        return (long long)nodeCount * (long long)sizeof(int);
+
+    }
+
+    ~LandmarkTable() {
+
+        if (!ownsArrays) return;
+        delete[] landmarks;
+        delete[] dist;
+
+    }
+};
+
+// ==================== MAZE CLASS ====================
+bool mazeSizeSupported(long long rows, long long cols) {
+
+    // PURPOSE: True when the maze, with the one-cell wall border the grid
+    // searches add around it (see IMPLICIT GRID GRAPH), has at most INT_MAX
+    // cells, so every cell id fits an int
+    return (rows + 2) * (cols + 2) <= INT_MAX;
+
+}
+
+class Maze {
+
+    // PURPOSE: Holds the maze as one walkability bit per cell
+    // Bit c % 64 of word r * rowWords + c / 64 is set when cell (r, c) is open.
+    // S and E are kept as coordinates. A maze may have several E cells: all
+    // are listed as exits, and the last one is the E the solvers search for.
+    // Digits '1'-'9' are open cells that cost that much to enter; ' ', 'S'
+    // and 'E' cost 1. Anything else is a wall.
+
+private:
+
+    unsigned long long* openBits;
+    unsigned char* costs;   // Per-cell digit (0 for none), only allocated when the maze has digits
+    int maxCost;
+    int rows, cols;
+    int rowWords;     // 64-bit words per row
+    int startRow, startCol;
+    int endRow, endCol;
+    long long loadBytes;   // Size of the last file loaded
+    double loadMs;         // Time spent loading it
+    MappedFile* mapping;   // Binary maze file the arrays point into, or NULL
+    CSRGraph* storedGraph; // Graph section of that file, or NULL
+    ComponentLabels* components;   // Built on first use, or read from a binary file
+    LandmarkTable* storedLandmarks;  // Landmarks section of a binary file, or NULL
+    int* exitCells;        // Every E cell as row * cols + col, in row-major order
+    int exitCount;
+    int exitCapacity;
+    bool edited;           // A cell changed since loading: the arrays are owned copies
+                           // and the stored graph and landmarks no longer match
+    long long editCount;   // Cell edits ever made; never goes back, so solvers can tell they are stale
+
+    void releaseData() {
+
+        // Arrays that live in a mapped file go away with the mapping
+        delete components;
+        components = NULL;
+        delete storedLandmarks;
+        storedLandmarks = NULL;
+        delete[] exitCells;
+        exitCells = NULL;
+        exitCount = exitCapacity = 0;
+        if (mapping != NULL) {
+            delete storedGraph;
+            delete mapping;
+        }
+        if (mapping == NULL || edited) {
+            delete[] openBits;
+            delete[] costs;
+        }
+        storedGraph = NULL;
+        mapping = NULL;
+        edited = false;
+        openBits = NULL;
+        costs = NULL;
+
+    }
+
+    bool validGraphSection(const int* section, int nodes, int edges, long long openCount) {
+
+        // PURPOSE: True when a stored graph is the row-major graph of the open
+        // cells: offsets rise from 0 to edges, every node sits on its open cell
+        // and every edge joins grid neighbors at a cost the maze allows
+        if (nodes != openCount) return false;
+        const int* offsets = section;
+        const int* dests = offsets + nodes + 1;
+        const int* weights = dests + edges;
+        const int* nodeRows = weights + edges;
+        const int* nodeCols = nodeRows + nodes;
+        if (offsets[0] != 0 || offsets[nodes] != edges) return false;
+
+        int node = 0;
+        for (int r = 0; r < rows; r++) {
+            for (int k = 0; k < rowWords; k++) {
+                unsigned long long open = openBits[(long long)r * rowWords + k];
+                while (open != 0) {
+                    int c = k * 64 + trailingZeros64(open);
+                    open &= open - 1;
+                    if (nodeRows[node] != r || nodeCols[node] != c) return false;
+                    node++;
+                }
+            }
+        }
+
+        for (int n = 0; n < nodes; n++) {
+            if (offsets[n + 1] < offsets[n] || offsets[n + 1] - offsets[n] > MAX_DEGREE) return false;
+            for (int e = offsets[n]; e < offsets[n + 1]; e++) {
+                int d = dests[e];
+                if (d < 0 || d >= nodes || weights[e] < 1 || weights[e] > maxCost) return false;
+                int dr = nodeRows[d] - nodeRows[n], dc = nodeCols[d] - nodeCols[n];
+                if ((dr < 0 ? -dr : dr) + (dc < 0 ? -dc : dc) != 1) return false;
+            }
+        }
+        return true;
+
+    }
+
+    bool validComponentsSection(const int* section, int runs, int componentTotal, long long openCount) {
+
+        // PURPOSE: True when stored run ranks match the open bits and every
+        // run label and component size is in range
+        const int* ranks = section;
+        const int* labels = ranks + (long long)rows * rowWords;
+        const int* sizeArray = labels + runs;
+        long long runTotal = 0;
+        for (int r = 0; r < rows; r++) {
+            unsigned long long carry = 0;
+            for (int k = 0; k < rowWords; k++) {
+                long long w = (long long)r * rowWords + k;
+                if (ranks[w] != runTotal) return false;
+                unsigned long long bits = openBits[w];
+                runTotal += popCount64(bits & ~((bits << 1) | carry));
+                carry = bits >> 63;
+            }
+        }
+        if (runTotal != runs || componentTotal > runs) return false;
+        for (int i = 0; i < runs; i++) {
+            if (labels[i] < 0 || labels[i] >= componentTotal) return false;
+        }
+        long long sizeTotal = 0;
+        for (int i = 0; i < componentTotal; i++) {
+            if (sizeArray[i] < 1) return false;
+            sizeTotal += sizeArray[i];
+        }
+        return sizeTotal == openCount;
+
+    }
+
+    bool validLandmarksSection(const int* section, int count, int nodes, long long openCount) {
+
+        // PURPOSE: True when stored landmarks are open-cell nodes and the table
+        // cannot make A* (Landmarks) overestimate: each landmark is 0 from itself,
+        // grid neighbors' distances differ by at most 1, and -1 marks exactly the
+        // cells outside the landmark's component. A table like that never rises
+        // faster than a path, so its bounds hold even if it is not exact BFS output.
+        if (nodes != openCount) return false;
+        for (int i = 0; i < count; i++) {
+            if (section[i] < 0 || section[i] >= nodes) return false;
+        }
+        const int* table = section + count;
+        for (int i = 0; i < count; i++) {
+            if (table[(long long)section[i] * count + i] != 0) return false;
+        }
+
+        ComponentLabels* labels = getComponents();
+        int* above = new int[cols];                     // Node of the cell above, -1 for a wall
+        long long* reached = new long long[count]();    // Distances other than -1, per landmark
+        int* landmarkLabel = new int[count];
+        for (int c = 0; c < cols; c++) above[c] = -1;
+
+        bool valid = true;
+        int node = 0;
+        for (int r = 0; r < rows && valid; r++) {
+            int left = -1;
+            for (int c = 0; c < cols && valid; c++) {
+
+                if (!isOpen(r, c)) {
+                    above[c] = left = -1;
+                    continue;
+                }
+
+                const int* dist = table + (long long)node * count;
+                const int* up = above[c] >= 0 ? table + (long long)above[c] * count : NULL;
+                const int* back = left >= 0 ? table + (long long)left * count : NULL;
+                for (int i = 0; i < count && valid; i++) {
+                    int d = dist[i];
+                    if (d < -1) valid = false;
+                    if (up != NULL && (d < 0) != (up[i] < 0)) valid = false;
+                    if (up != NULL && d >= 0 && (d - up[i] > 1 || up[i] - d > 1)) valid = false;
+                    if (back != NULL && (d < 0) != (back[i] < 0)) valid = false;
+                    if (back != NULL && d >= 0 && (d - back[i] > 1 || back[i] - d > 1)) valid = false;
+                    if (d >= 0) reached[i]++;
+                    if (section[i] == node) landmarkLabel[i] = labels->getLabel(r, c);
+                }
+                above[c] = left = node;
+                node++;
+
+            }
+        }
+
+        // Neighbors agree on -1, so each component is all -1 or all distances;
+        // the landmark's own component is the one that must have distances
+        for (int i = 0; i < count && valid; i++) {
+            if (reached[i] != labels->getComponentSize(landmarkLabel[i])) valid = false;
+        }
+
+        delete[] above;
+        delete[] reached;
+        delete[] landmarkLabel;
+        return valid;
+
+    }
+
+    bool loadFromBinary(MappedFile* file) {
+
+        // PURPOSE: Point the maze at the sections of a mapped binary maze file
+        // The bits and costs are used in place and must be sound, or the file
+        // is rejected. The graph, components and landmarks are checked against
+        // the bits before use; a section that fails is dropped with a warning,
+        // and the solvers rebuild it as they would for a text maze.
+        // Takes ownership of file.
+        const char* data = file->getData();
+        long long len = file->getSize();
+        MazeFileHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        if (header.version != MAZE_FILE_VERSION) {
+            cout << "Error: Unsupported binary maze version " << header.version << endl;
+            delete file;
+            return false;
+        }
+
+        long long cells = (long long)header.rows * header.cols;
+        long long words = (long long)header.rows * header.rowWords + 1;
+        bool hasCosts = (header.flags & MAZE_FILE_HAS_COSTS) != 0;
+        bool hasGraph = (header.flags & MAZE_FILE_HAS_GRAPH) != 0;
+        bool hasComponents = (header.flags & MAZE_FILE_HAS_COMPONENTS) != 0;
+        bool hasLandmarks = (header.flags & MAZE_FILE_HAS_LANDMARKS) != 0;
+        bool hasExits = (header.flags & MAZE_FILE_HAS_EXITS) != 0;
+        long long graphBytes = ((long long)header.nodeCount * 3 + 1 + (long long)header.edgeCount * 2) *
+            (long long)sizeof(int);
+        bool valid = header.rows > 0 && header.cols > 0 && mazeSizeSupported(header.rows, header.cols) &&
+            header.rowWords == (header.cols + 63) / 64 && header.fileSize == len &&
+            header.startRow >= 0 && header.startRow < header.rows &&
+            header.startCol >= 0 && header.startCol < header.cols &&
+            header.endRow >= 0 && header.endRow < header.rows &&
+            header.endCol >= 0 && header.endCol < header.cols &&
+            header.maxCost >= 1 && header.maxCost <= 9 && (hasCosts || header.maxCost == 1) &&
+            header.bitsOffset % MAZE_FILE_ALIGN == 0 && header.bitsOffset >= (long long)sizeof(header) &&
+            header.bitsOffset + words * 8 <= len;
+        if (valid && hasCosts) {
+            valid = header.costsOffset % MAZE_FILE_ALIGN == 0 && header.costsOffset > 0 &&
+                header.costsOffset + cells <= len;
+            const unsigned char* section = (const unsigned char*)(data + header.costsOffset);
+            for (long long i = 0; valid && i < cells; i++) valid = section[i] <= header.maxCost;
+        }
+        if (valid) {
+            // No open bits past the last column, nor in the padding word
+            const unsigned long long* bits = (const unsigned long long*)(data + header.bitsOffset);
+            unsigned long long spare = header.cols % 64 == 0 ? 0 : ~0ULL << (header.cols % 64);
+            for (int r = 0; valid && r < header.rows; r++) {
+                valid = (bits[(long long)(r + 1) * header.rowWords - 1] & spare) == 0;
+            }
+            valid = valid && bits[words - 1] == 0;
+        }
+        if (!valid) {
+            cout << "Error: Corrupt binary maze file" << endl;
+            delete file;
+            return false;
+        }
+
+        mapping = file;
+        rows = header.rows;
+        cols = header.cols;
+        rowWords = header.rowWords;
+        startRow = header.startRow;
+        startCol = header.startCol;
+        endRow = header.endRow;
+        endCol = header.endCol;
+        maxCost = header.maxCost;
+
+        // The maze never writes its arrays after loading, so they can stay read-only
+        openBits = (unsigned long long*)(data + header.bitsOffset);
+        if (hasCosts) costs = (unsigned char*)(data + header.costsOffset);
+
+        long long openCount = 0;
+        for (long long w = 0; w < words; w++) openCount += popCount64(openBits[w]);
+
+        if (hasGraph) {
+            const int* section = (const int*)(data + header.graphOffset);
+            int nodes = header.nodeCount;
+            int edges = header.edgeCount;
+            if (header.graphOffset % MAZE_FILE_ALIGN == 0 && header.graphOffset > 0 && nodes >= 0 && edges >= 0 &&
+                header.graphOffset + graphBytes <= len && validGraphSection(section, nodes, edges, openCount)) {
+                storedGraph = new CSRGraph(nodes, edges, section, section + nodes + 1,
+                                           section + nodes + 1 + edges, section + nodes + 1 + 2LL * edges,
+                                           section + 2LL * nodes + 1 + 2LL * edges);
+            } else {
+                cout << "Warning: Corrupt graph section in binary maze file; the graph will be rebuilt" << endl;
+            }
+        }
+
+        if (hasComponents) {
+            const int* section = (const int*)(data + header.componentsOffset);
+            long long rankWords = words - 1;
+            if (header.componentsOffset % MAZE_FILE_ALIGN == 0 && header.componentsOffset > 0 &&
+                header.runCount >= 0 && header.componentCount >= 0 &&
+                header.componentsOffset + (rankWords + header.runCount + header.componentCount) *
+                (long long)sizeof(int) <= len &&
+                validComponentsSection(section, header.runCount, header.componentCount, openCount)) {
+                components = new ComponentLabels(openBits, rows, cols, rowWords, header.runCount,
+                                                 header.componentCount, section, section + rankWords,
+                                                 section + rankWords + header.runCount);
+            } else {
+                cout << "Warning: Corrupt components section in binary maze file; labels will be rebuilt" << endl;
+            }
+        }
+
+        if (hasLandmarks) {
+            const int* section = (const int*)(data + header.landmarksOffset);
+            if (header.landmarksOffset % MAZE_FILE_ALIGN == 0 && header.landmarksOffset > 0 &&
+                header.landmarkCount > 0 && header.landmarkNodeCount >= 0 &&
+                header.landmarksOffset + (long long)header.landmarkCount * (header.landmarkNodeCount + 1) *
+                (long long)sizeof(int) <= len &&
+                validLandmarksSection(section, header.landmarkCount, header.landmarkNodeCount, openCount)) {
+                storedLandmarks = new LandmarkTable(header.landmarkCount, header.landmarkNodeCount,
+                                                    section, section + header.landmarkCount);
+            } else {
+                cout << "Warning: Corrupt landmarks section in binary maze file; landmarks will be rebuilt" << endl;
+            }
+        }
+
+        // Copied, since the list is short and edits must not touch the mapping
+        bool exitsValid = hasExits && header.exitsOffset % MAZE_FILE_ALIGN == 0 && header.exitsOffset > 0 &&
+            header.exitCount > 0 && header.exitsOffset + (long long)header.exitCount * (long long)sizeof(int) <= len;
+        if (exitsValid) {
+            const int* section = (const int*)(data + header.exitsOffset);
+            for (int i = 0; exitsValid && i < header.exitCount; i++) exitsValid = section[i] >= 0 && section[i] < cells;
+            for (int i = 0; exitsValid && i < header.exitCount; i++) addExit(section[i]);
+        }
+        if (!exitsValid) {
+            if (hasExits) cout << "Warning: Corrupt exits section in binary maze file; only E is an exit" << endl;
+            addExit(endRow * cols + endCol);
+        }
+
+        if (!isOpen(startRow, startCol) || !isOpen(endRow, endCol)) {
+            cout << "Error: Start (S) or End (E) not found in maze!" << endl;
+            return false;
+        }
+
+        return true;
+
+    }
+
+    void setCost(int r, int c, int cost) {
+
+        if (costs == NULL) costs = new unsigned char[(long long)rows * cols]();
+        costs[(long long)r * cols + c] = (unsigned char)cost;
+        if (cost > maxCost) maxCost = cost;
+
+    }
+
+    void addExit(int cell) {
+
+        if (exitCount == exitCapacity) {
+            exitCapacity = exitCapacity == 0 ? 4 : exitCapacity * 2;
+            int* grown = new int[exitCapacity];
+            for (int i = 0; i < exitCount; i++) grown[i] = exitCells[i];
+            delete[] exitCells;
+            exitCells = grown;
+        }
+        exitCells[exitCount++] = cell;
+
+    }
+
+    long long nextNewline(const char* data, long long from, long long len) {
+
+        // PURPOSE: Index of the first '\n' at or after from, or len if none
+        long long i = from;
+        while (i + 64 <= len) {
+            unsigned long long mask = newlineMask64(data + i);
+            if (mask != 0) return i + trailingZeros64(mask);
+            i += 64;
+        }
+        while (i < len && data[i] != '\n') i++;
+        return i;
+
+    }
+
+    void markSpecialCell(const char* line, int r, long long j) {
+
+        // PURPOSE: Record S, E or a cell cost found while classifying a row
+        char cell = line[j];
+        if (cell == 'S') {
+            startRow = r;
+            startCol = (int)j;
+        } else if (cell == 'E') {
+            endRow = r;
+            endCol = (int)j;
+            addExit(r * cols + (int)j);
+        } else {
+            setCost(r, (int)j, cell - '0');
+        }
+
+    }
+
+    bool parseBuffer(const char* data, long long len) {
+
+        // PURPOSE: Build the walkability bits straight from the file text
+        // First pass measures the maze, second pass classifies each row 64
+        // cells at a time into whole bit words; only S, E and digits are
+        // looked at one by one. The text is read in place, never copied.
+
+        rows = 0;
+        cols = 0;
+        long long lineStart = 0;
+        while (lineStart < len) {
+            long long lineEnd = nextNewline(data, lineStart, len);
+            long long lineLen = lineEnd - lineStart;
+            if (lineLen > 0 && data[lineEnd - 1] == '\r') lineLen--;
+            if (lineEnd < len || lineLen > 0) {
+                if (lineLen > cols) {
+                    if (lineLen > INT_MAX) {
+                        cout << "Error: Maze line too long" << endl;
+                        return false;
+                    }
+                    cols = (int)lineLen;
+                }
+                if (rows == INT_MAX) {
+                    cout << "Error: Too many maze rows" << endl;
+                    return false;
+                }
+                rows++;
+            }
+            lineStart = lineEnd + 1;
+        }
+
+        if (!mazeSizeSupported(rows, cols)) {
+            cout << "Error: Maze is " << rows << " x " << cols << "; with a wall border around it, at most "
+                 << INT_MAX << " cells are supported" << endl;
+            return false;
+        }
+
+        rowWords = (cols + 63) / 64;
+
+        // Short lines are padded with walls
+        openBits = new unsigned long long[(long long)rows * rowWords + 1]();
+
+        lineStart = 0;
+        for (int r = 0; r < rows; r++) {
+
+            long long lineEnd = nextNewline(data, lineStart, len);
+            long long lineLen = lineEnd - lineStart;
+            if (lineLen > 0 && data[lineEnd - 1] == '\r') lineLen--;
+            const char* line = data + lineStart;
+            unsigned long long* row = openBits + (long long)r * rowWords;
+
+            for (long long base = 0; base < lineLen; base += 64) {
+                long long count = lineLen - base < 64 ? lineLen - base : 64;
+                unsigned long long valid = count == 64 ? ~0ULL : (1ULL << count) - 1;
+                unsigned long long open, special;
+                if (lineStart + base + 64 <= len) {
+                    open = classifyCells64(line + base, special);
+                } else {
+                    // Too close to the end of the text for a 64-byte read
+                    open = 0;
+                    special = 0;
+                    for (long long j = 0; j < count; j++) {
+                        char cell = line[base + j];
+                        bool mark = (cell == 'S' || cell == 'E' || (cell >= '1' && cell <= '9'));
+                        if (mark) special |= 1ULL << j;
+                        if (mark || cell == ' ') open |= 1ULL << j;
+                    }
+                }
+                row[base >> 6] = open & valid;
+                special &= valid;
+                while (special != 0) {
+                    markSpecialCell(line, r, base + trailingZeros64(special));
+                    special &= special - 1;
+                }
+            }
+
+            lineStart = lineEnd + 1;
+
+        }
+
+        return true;
+
+    }
+    
+public:
+    Maze() : openBits(NULL), costs(NULL), maxCost(1), rows(0), cols(0), rowWords(0), startRow(-1), startCol(-1),
+        endRow(-1), endCol(-1), loadBytes(0), loadMs(0), mapping(NULL), storedGraph(NULL),
+        components(NULL), storedLandmarks(NULL), exitCells(NULL), exitCount(0), exitCapacity(0), edited(false),
+        editCount(0) {}
+    
+    bool loadFromFile(const char* filename) {
+
+        // The file is mapped and parsed in place (see MappedFile). A binary
+        // maze file is not parsed at all: the maze keeps the mapping and
+        // reads its cells straight from it.
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        MappedFile* file = new MappedFile();
+        if (!file->open(filename)) {
+            cout << "Error: Cannot open file " << filename << endl;
+            delete file;
+            return false;
+        }
+
+        loadBytes = file->getSize();
+        bool ok;
+        if (isBinaryMaze(file->getData(), file->getSize())) {
+            releaseData();
+            ok = loadFromBinary(file);
+        } else {
+            ok = loadFromText(file->getData(), file->getSize());
+            delete file;
+        }
+        loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        return ok;
+    }
+
+    bool loadFromText(const char* data, long long len) {
+
+        // PURPOSE: Load a maze from text already in memory (same format as the file)
+        // USED IN: loadFromFile, benchmark corpus
+        releaseData();
+        maxCost = 1;
+        rows = 0;
+        cols = 0;
+        rowWords = 0;
+        startRow = startCol = endRow = endCol = -1;
+
+        if (!parseBuffer(data, len)) return false;
+        
+        if (startRow == -1 || endRow == -1) {
+            cout << "Error: Start (S) or End (E) not found in maze!" << endl;
+            return false;
+        }
+        
+        return true;
+
+    }
+    
+    void display() {
+        char* line = new char[cols + 1];
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                line[j] = getCell(i, j);
+            }
+            cout.write(line, cols);
+            cout << endl;
+        }
+        delete[] line;
+    }
+    
+    void displayWithPath(int path[], int pathLen) {
+        char* tempGrid = new char[(long long)rows * cols];
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                tempGrid[(long long)i * cols + j] = getCell(i, j);
+            }
+        }
+        
+        for (int i = 0; i < pathLen; i++) {
+            if (tempGrid[path[i]] != 'S' && tempGrid[path[i]] != 'E') {
+                tempGrid[path[i]] = '~';
+            }
+        }
+        
+        for (int i = 0; i < rows; i++) {
+            cout.write(tempGrid + (long long)i * cols, cols);
+            cout << endl;
+        }
+
+        delete[] tempGrid;
+    }
+
+    bool isOpen(int r, int c) {
+
+        if (r >= 0 && r < rows && c >= 0 && c < cols) {
+
+            return (openBits[(long long)r * rowWords + (c >> 6)] >> (c & 63)) & 1;
+
+        }
+
+        return false;
+
+    }
+    
+    char getCell(int r, int c) {
+
+        if (!isOpen(r, c)) return '#';
+        if (r == startRow && c == startCol) return 'S';
+        if (r == endRow && c == endCol) return 'E';
+        if (costs != NULL && costs[(long long)r * cols + c] != 0) {
+            return (char)('0' + costs[(long long)r * cols + c]);
+        }
+        return ' ';
+
+    }
+
+    int getCost(int r, int c) {
+
+        // PURPOSE: Cost of stepping into cell (r, c)
+        if (costs == NULL) return 1;
+        int digit = costs[(long long)r * cols + c];
+        return digit != 0 ? digit : 1;
+
+    }
+
+    bool hasWeights() {
+
+        return maxCost > 1;
+
+    }
+
+    int getMaxCost() {
+
+        return maxCost;
+
+    }
+
+    long long getPathCost(int path[], int pathLen) {
+
+        // PURPOSE: Total cost of a path given as cell indices (the start is free)
+        long long total = 0;
+        for (int i = 1; i < pathLen; i++) {
+            total += getCost(path[i] / cols, path[i] % cols);
+        }
+        return total;
+
+    }
+
+    long long getLoadBytes() {
+
+        return loadBytes;
+
+    }
+
+    double getLoadMs() {
+
+        return loadMs;
+
+    }
+
+    const unsigned long long* getOpenBits() {
+
+        return openBits;
+
+    }
+
+    const unsigned char* getCosts() {
+
+        // PURPOSE: Per-cell digits (row * cols + col; 0 where there is none, which
+        // costs 1), or NULL when the maze has no digits
+        return costs;
+
+    }
+
+    ComponentLabels* getComponents() {
+
+        // PURPOSE: Connected-component labels of the open cells (built on first use)
+        // Not thread-safe on the first call; batch mode builds them up front
+        if (components == NULL) components = new ComponentLabels(openBits, rows, cols, rowWords);
+        return components;
+
+    }
+
+    CSRGraph* getStoredGraph() {
+
+        // PURPOSE: Graph loaded with a binary maze file, or NULL (owned by the maze)
+        // NULL once a cell has been edited, since it no longer matches
+        return edited ? NULL : storedGraph;
+
+    }
+
+    LandmarkTable* getStoredLandmarks() {
+
+        // PURPOSE: Landmarks loaded with a binary maze file, or NULL (owned by the maze)
+        // Nodes are numbered like the stored graph (row-major)
+        return edited ? NULL : storedLandmarks;
+
+    }
+
+    int getExitCount() {
+
+        return exitCount;
+
+    }
+
+    const int* getExitCells() {
+
+        // PURPOSE: Every E cell as row * cols + col; the last is (getEndRow(), getEndCol())
+        return exitCells;
+
+    }
+
+    bool setOpen(int r, int c, bool open) {
+
+        // PURPOSE: Make cell (r, c) a wall or an open cell (costing 1) in place
+        // Returns false for S, E and cells outside the maze. The first edit of a
+        // binary maze copies its bits and costs out of the read-only mapping;
+        // the stored sections stay mapped for solvers built before it.
+        // Component labels are dropped and rebuilt on next use. A MazeSolver
+        // built before an edit is stale from then on and answers no query (see
+        // MazeSolver::isStale); build a new one. IncrementalPlanner follows edits.
+        if (r < 0 || r >= rows || c < 0 || c >= cols) return false;
+        if ((r == startRow && c == startCol) || (r == endRow && c == endCol)) return false;
+
+        if (!edited && mapping != NULL) {
+            long long words = (long long)rows * rowWords + 1;
+            unsigned long long* bits = new unsigned long long[words];
+            memcpy(bits, openBits, (size_t)words * 8);
+            openBits = bits;
+            if (costs != NULL) {
+                unsigned char* ownCosts = new unsigned char[(long long)rows * cols];
+                memcpy(ownCosts, costs, (size_t)rows * (size_t)cols);
+                costs = ownCosts;
+            }
+        }
+        edited = true;
+        editCount++;
+
+        unsigned long long bit = 1ULL << (c & 63);
+        long long word = (long long)r * rowWords + (c >> 6);
+        if (open) openBits[word] |= bit;
+        else openBits[word] &= ~bit;
+        if (open && costs != NULL) costs[(long long)r * cols + c] = 0;
+
+        delete components;
+        components = NULL;
+        return true;
+
+    }
+
+    long long getEditCount() {
+
+        return editCount;
+
+    }
+
+    bool isBinary() {
+
+        return mapping != NULL;
+
+    }
+
+    int getRowWords() {
+
+        return rowWords;
+
+    }
+    
+    int getRows() {
+
+         return rows;
+
+         }
+
+    int getCols() { 
+
+        return cols;
+
+     }
+
+    int getStartRow() {
+
+         return startRow;
+
+         }
+
+    int getStartCol() {
+
+         return startCol;
+
+         }
+
+    int getEndRow() {
+
+         return endRow;
+
+         }
+
+    int getEndCol() { 
+
+        return endCol;
+
+     }
+
+    ~Maze() {
+
+        releaseData();
+
+    }
+
+};
+
+// ==================== BINARY MAZE CONVERTER ====================
+// PURPOSE: Save a loaded maze in the binary format (see BINARY MAZE FORMAT)
+// USED IN: --convert
+
+void padFileTo(ofstream& out, long long& offset, long long target) {
+
+    static const char zeros[MAZE_FILE_ALIGN] = {0};
+    while (offset < target) {
+        long long n = target - offset < MAZE_FILE_ALIGN ? target - offset : MAZE_FILE_ALIGN;
+        out.write(zeros, n);
+        offset += n;
+    }
+
+}
+
+bool writeBinaryMaze(Maze* maze, CSRGraph* graph, ComponentLabels* components, LandmarkTable* landmarks,
+                     const char* filename, long long& fileSize) {
+
+    // PURPOSE: Write maze (and graph, components and landmarks, if not NULL)
+    // to filename; fileSize gets the byte count
+    // graph and landmarks must number the open cells in row-major order, as
+    // MazeSolver does by default
+    MazeFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAZE_FILE_MAGIC, 8);
+    header.version = MAZE_FILE_VERSION;
+    header.rows = maze->getRows();
+    header.cols = maze->getCols();
+    header.rowWords = maze->getRowWords();
+    header.startRow = maze->getStartRow();
+    header.startCol = maze->getStartCol();
+    header.endRow = maze->getEndRow();
+    header.endCol = maze->getEndCol();
+    header.maxCost = maze->getMaxCost();
+
+    long long cells = (long long)header.rows * header.cols;
+    long long words = (long long)header.rows * header.rowWords + 1;
+    header.bitsOffset = alignFileOffset(sizeof(header));
+    long long end = header.bitsOffset + words * 8;
+    if (maze->getCosts() != NULL) {
+        header.flags |= MAZE_FILE_HAS_COSTS;
+        header.costsOffset = alignFileOffset(end);
+        end = header.costsOffset + cells;
+    }
+    if (graph != NULL) {
+        header.flags |= MAZE_FILE_HAS_GRAPH;
+        header.nodeCount = graph->getNodeCount();
+        header.edgeCount = graph->getEdgeCount();
+        header.graphOffset = alignFileOffset(end);
+        end = header.graphOffset +
+              ((long long)header.nodeCount * 3 + 1 + (long long)header.edgeCount * 2) * (long long)sizeof(int);
+    }
+    if (components != NULL) {
+        header.flags |= MAZE_FILE_HAS_COMPONENTS;
+        header.runCount = components->getRunCount();
+        header.componentCount = components->getComponentCount();
+        header.componentsOffset = alignFileOffset(end);
+        end = header.componentsOffset + (words - 1 + header.runCount + header.componentCount) * (long long)sizeof(int);
+    }
+    if (landmarks != NULL) {
+        header.flags |= MAZE_FILE_HAS_LANDMARKS;
+        header.landmarkCount = landmarks->getCount();
+        header.landmarkNodeCount = landmarks->getNodeCount();
+        header.landmarksOffset = alignFileOffset(end);
+        end = header.landmarksOffset +
+            (long long)header.landmarkCount * (header.landmarkNodeCount + 1) * (long long)sizeof(int);
+    }
+    if (maze->getExitCount() > 1) {
+        header.flags |= MAZE_FILE_HAS_EXITS;
+        header.exitCount = maze->getExitCount();
+        header.exitsOffset = alignFileOffset(end);
+        end = header.exitsOffset + (long long)header.exitCount * (long long)sizeof(int);
+    }
+    header.fileSize = end;
+
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) {
+        cout << "Error: Cannot write " << filename << endl;
+        return false;
+    }
+
+    long long offset = sizeof(header);
+    out.write((const char*)&header, sizeof(header));
+
+    padFileTo(out, offset, header.bitsOffset);
+    out.write((const char*)maze->getOpenBits(), words * 8);
+    offset += words * 8;
+
+    if (header.flags & MAZE_FILE_HAS_COSTS) {
+        padFileTo(out, offset, header.costsOffset);
+        out.write((const char*)maze->getCosts(), cells);
+        offset += cells;
+    }
+
+    if (header.flags & MAZE_FILE_HAS_GRAPH) {
+        padFileTo(out, offset, header.graphOffset);
+        long long nodeBytes = (long long)header.nodeCount * (long long)sizeof(int);
+        long long edgeBytes = (long long)header.edgeCount * (long long)sizeof(int);
+        out.write((const char*)graph->getOffsets(), nodeBytes + (long long)sizeof(int));
+        out.write((const char*)graph->getDests(), edgeBytes);
+        out.write((const char*)graph->getWeights(), edgeBytes);
+        out.write((const char*)graph->getNodeRows(), nodeBytes);
+        out.write((const char*)graph->getNodeCols(), nodeBytes);
+        offset += 3 * nodeBytes + (long long)sizeof(int) + 2 * edgeBytes;
+    }
+
+    if (header.flags & MAZE_FILE_HAS_COMPONENTS) {
+        padFileTo(out, offset, header.componentsOffset);
+        long long intCount = words - 1 + header.runCount + header.componentCount;
+        out.write((const char*)components->getRunRanks(), (words - 1) * (long long)sizeof(int));
+        out.write((const char*)components->getRunLabels(), (long long)header.runCount * (long long)sizeof(int));
+        out.write((const char*)components->getSizes(), (long long)header.componentCount * (long long)sizeof(int));
+        offset += intCount * (long long)sizeof(int);
+    }
+
+    if (header.flags & MAZE_FILE_HAS_LANDMARKS) {
+        padFileTo(out, offset, header.landmarksOffset);
+        long long tableBytes = (long long)header.landmarkCount * header.landmarkNodeCount * (long long)sizeof(int);
+        out.write((const char*)landmarks->getLandmarks(), (long long)header.landmarkCount * (long long)sizeof(int));
+        out.write((const char*)landmarks->getTable(), tableBytes);
+        offset += (long long)header.landmarkCount * (long long)sizeof(int) + tableBytes;
+    }
+
+    if (header.flags & MAZE_FILE_HAS_EXITS) {
+        padFileTo(out, offset, header.exitsOffset);
+        out.write((const char*)maze->getExitCells(), (long long)header.exitCount * (long long)sizeof(int));
+        offset += (long long)header.exitCount * (long long)sizeof(int);
+    }
+
+    out.close();
+    if (out.fail()) {
+        cout << "Error: Failed writing " << filename << endl;
+        return false;
+    }
+
+    fileSize = offset;
+    return true;
+
+}
+
+// ==================== IMPLICIT GRID GRAPH ====================
+// PURPOSE: Search the maze grid directly, without building nodes or edges
+// Node id of cell (r, c) is (r + 1) * stride + (c + 1), where stride = cols + 2.
+// A one-cell wall border around the maze means neighbors are always id +/- 1
+// and id +/- stride, with no bounds checks.
+// USED IN: MazeSolver implicit-grid mode
+
+class GridGraph {
+
+private:
+    unsigned char* cells;   // Entry cost of an open cell (1-9), 0 = wall (including the border)
+    int rows, cols;
+    int stride;
+    int nodeSpace;          // (rows + 2) * stride ids, walls included
+    int openCount;
+
+public:
+
+    GridGraph(Maze* maze) : rows(maze->getRows()), cols(maze->getCols()), openCount(0) {
+
+        // Maze only accepts sizes whose bordered grid fits an int (mazeSizeSupported)
+        stride = cols + 2;
+        nodeSpace = (rows + 2) * stride;
+
+        cells = new unsigned char[nodeSpace]();
+        for (int r = 0; r < rows; r++) {
+            unsigned char* row = cells + (r + 1) * stride + 1;
+            for (int c = 0; c < cols; c++) {
+                if (maze->isOpen(r, c)) {
+                    row[c] = (unsigned char)maze->getCost(r, c);
+                    openCount++;
+                }
+            }
+        }
+
+    }
+
+    int getNodeSpace() {
+
+        return nodeSpace;
+
+    }
+
+    int getOpenCount() {
+
+        return openCount;
+
+    }
+
+    int getStride() {
+
+        return stride;
+
+    }
+
+    bool isOpen(int node) {
+
+        return cells[node] != 0;
+
+    }
+
+    int getCost(int node) {
+
+        return cells[node];
+
+    }
+
+    void setCost(int node, int cost) {
+
+        // PURPOSE: Open a cell at this entry cost, or make it a wall (0), in place
+        if (cells[node] == 0 && cost != 0) openCount++;
+        if (cells[node] != 0 && cost == 0) openCount--;
+        cells[node] = (unsigned char)cost;
+
+    }
+
+    int nodeAt(int r, int c) {
+
+        return (r + 1) * stride + (c + 1);
+
+    }
+
+    void getNodeCoords(int node, int& row, int& col) {
+
+        row = node / stride - 1;
+        col = node % stride - 1;
+
+    }
+
+    int getNeighbors(int node, int nbrs[]) {
+
+        // Right, left, down, up: the same order as the explicit graph's edges
+        int count = 0;
+        if (cells[node + 1]) nbrs[count++] = node + 1;
+        if (cells[node - 1]) nbrs[count++] = node - 1;
+        if (cells[node + stride]) nbrs[count++] = node + stride;
+        if (cells[node - stride]) nbrs[count++] = node - stride;
+        return count;
+
+    }
+
+    ~GridGraph() {
+
+        delete[] cells;
+
+    }
+};
+
+// ==================== BIT-PARALLEL BFS ====================
+// PURPOSE: BFS that expands a whole frontier level with word-wide bit operations
+// The frontier, visited set and open cells are bitmaps. One level is
+//   next = (up | down | left | right of frontier) & open & ~visited
+// computed 64 cells per word (256 per step with AVX2).
+// Instead of a bitmap per level, each cell's level mod 3 is kept in two bit
+// planes. Grid neighbors differ by at most one level, so walking back from E
+// to the neighbor at level - 1 (mod 3) always retraces a shortest path, and
+// memory stays at a fixed 6 bits per cell.
+// The bitmaps are allocated once; each search first clears only the rows the
+// previous one reached.
+// USED IN: MazeSolver::solveBFSBitParallel
+
+class BitParallelBFS {
+
+private:
+    int rows, cols;
+    int rowWords;      // Data words per row
+    int stride;        // Words per padded row: pad word, data words, trailing pad words
+    unsigned long long* open;
+    unsigned long long* visited;
+    unsigned long long* frontier;
+    unsigned long long* next;
+    unsigned long long* levelLow;     // Bit 0 of (level mod 3)
+    unsigned long long* levelHigh;    // Bit 1 of (level mod 3)
+    int* frontLo;      // Per padded row: first and last nonzero frontier word
+    int* frontHi;
+    int* nextLo;
+    int* nextHi;
+    int touchedLo, touchedHi;   // Padded rows where the last search set visited and level bits
+
+    long long wordIndex(int r, int c) {
+
+        // Padded row r + 1, data words start at index 1
+        return (long long)(r + 1) * stride + 1 + (c >> 6);
+
+    }
+
+    bool testBit(unsigned long long* map, int r, int c) {
+
+        return (map[wordIndex(r, c)] >> (c & 63)) & 1;
+
+    }
+
+    void setBit(unsigned long long* map, int r, int c) {
+
+        map[wordIndex(r, c)] |= 1ULL << (c & 63);
+
+    }
+
+    int levelMod3(int r, int c) {
+
+        return (testBit(levelLow, r, c) ? 1 : 0) | (testBit(levelHigh, r, c) ? 2 : 0);
+
+    }
+
+    void expandRow(int pr, int lo, int hi, int level, int& foundLo, int& foundHi, long long& newCells) {
+
+        // PURPOSE: Compute next-frontier words lo..hi of padded row pr
+        unsigned long long* f = frontier + (long long)pr * stride;
+        unsigned long long* up = f - stride;
+        unsigned long long* down = f + stride;
+        unsigned long long* o = open + (long long)pr * stride;
+        unsigned long long* v = visited + (long long)pr * stride;
+        unsigned long long* n = next + (long long)pr * stride;
+        unsigned long long* pLow = levelLow + (long long)pr * stride;
+        unsigned long long* pHigh = levelHigh + (long long)pr * stride;
+        bool markLow = (level % 3) & 1;
+        bool markHigh = (level % 3) & 2;
+
+        int w = lo;
+#if defined(__AVX2__)
+        for (; w <= hi; w += 4) {
+            __m256i fw = _mm256_loadu_si256((const __m256i*)(f + w));
+            __m256i fl = _mm256_loadu_si256((const __m256i*)(f + w - 1));
+            __m256i fr = _mm256_loadu_si256((const __m256i*)(f + w + 1));
+            __m256i x = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(up + w)),
+                                        _mm256_loadu_si256((const __m256i*)(down + w)));
+            x = _mm256_or_si256(x, _mm256_or_si256(_mm256_slli_epi64(fw, 1), _mm256_srli_epi64(fl, 63)));
+            x = _mm256_or_si256(x, _mm256_or_si256(_mm256_srli_epi64(fw, 1), _mm256_slli_epi64(fr, 63)));
+            __m256i vw = _mm256_loadu_si256((const __m256i*)(v + w));
+            x = _mm256_andnot_si256(vw, _mm256_and_si256(x, _mm256_loadu_si256((const __m256i*)(o + w))));
+            _mm256_storeu_si256((__m256i*)(n + w), x);
+            if (_mm256_testz_si256(x, x)) continue;
+
+            _mm256_storeu_si256((__m256i*)(v + w), _mm256_or_si256(vw, x));
+            if (markLow) {
+                _mm256_storeu_si256((__m256i*)(pLow + w),
+                                    _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(pLow + w)), x));
+            }
+            if (markHigh) {
+                _mm256_storeu_si256((__m256i*)(pHigh + w),
+                                    _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(pHigh + w)), x));
+            }
+            for (int k = 0; k < 4; k++) {
+                if (n[w + k]) {
+                    if (w + k < foundLo) foundLo = w + k;
+                    if (w + k > foundHi) foundHi = w + k;
+                    newCells += popCount64(n[w + k]);
+                }
+            }
+        }
+#else
+        for (; w <= hi; w++) {
+            unsigned long long x = up[w] | down[w]
+                                 | (f[w] << 1) | (f[w - 1] >> 63)
+                                 | (f[w] >> 1) | (f[w + 1] << 63);
+            x &= o[w] & ~v[w];
+            n[w] = x;
+            if (x == 0) continue;
+
+            v[w] |= x;
+            if (markLow) pLow[w] |= x;
+            if (markHigh) pHigh[w] |= x;
+            if (w < foundLo) foundLo = w;
+            if (w > foundHi) foundHi = w;
+            newCells += popCount64(x);
+        }
+#endif
+
+    }
+
+    void clearFrontierRow(int pr) {
+
+        if (frontHi[pr] < 0) return;
+        memset(frontier + (long long)pr * stride + frontLo[pr], 0,
+               sizeof(unsigned long long) * (size_t)(frontHi[pr] - frontLo[pr] + 1));
+        frontLo[pr] = INT_MAX;
+        frontHi[pr] = -1;
+
+    }
+
+    void reset() {
+
+        // PURPOSE: Clear what the last search left: its final frontier and the
+        // visited and level bits of the rows it reached (a contiguous block)
+        if (touchedHi < 0) return;
+        for (int pr = touchedLo; pr <= touchedHi; pr++) clearFrontierRow(pr);
+        long long first = (long long)touchedLo * stride;
+        size_t bytes = sizeof(unsigned long long) * (size_t)(touchedHi - touchedLo + 1) * (size_t)stride;
+        memset(visited + first, 0, bytes);
+        memset(levelLow + first, 0, bytes);
+        memset(levelHigh + first, 0, bytes);
+        touchedLo = INT_MAX;
+        touchedHi = -1;
+
+    }
+
+public:
+
+    BitParallelBFS(Maze* maze) : rows(maze->getRows()), cols(maze->getCols()), rowWords(maze->getRowWords()),
+        touchedLo(INT_MAX), touchedHi(-1) {
+
+        // Room for the pad word in front and 4-word vector loads past the last data word
+        stride = ((rowWords + 5 + 3) / 4) * 4;
+        long long total = (long long)(rows + 2) * stride;
+
+        open = new unsigned long long[total]();
+        visited = new unsigned long long[total]();
+        frontier = new unsigned long long[total]();
+        next = new unsigned long long[total]();
+        levelLow = new unsigned long long[total]();
+        levelHigh = new unsigned long long[total]();
+        frontLo = new int[rows + 2];
+        frontHi = new int[rows + 2];
+        nextLo = new int[rows + 2];
+        nextHi = new int[rows + 2];
+        for (int r = 0; r < rows + 2; r++) {
+            frontLo[r] = nextLo[r] = INT_MAX;
+            frontHi[r] = nextHi[r] = -1;
+        }
+
+        const unsigned long long* src = maze->getOpenBits();
+        for (int r = 0; r < rows; r++) {
+            memcpy(open + (long long)(r + 1) * stride + 1, src + (long long)r * rowWords,
+                   sizeof(unsigned long long) * (size_t)rowWords);
+        }
+
+    }
+
+    bool solve(int sr, int sc, int er, int ec, int path[], int& pathLen, int& nodesVisited) {
+
+        reset();
+        pathLen = 0;
+        nodesVisited = 0;
+        if (!testBit(open, sr, sc) || !testBit(open, er, ec)) return false;
+
+        setBit(frontier, sr, sc);
+        setBit(visited, sr, sc);
+        int startWord = 1 + (sc >> 6);
+        frontLo[sr + 1] = frontHi[sr + 1] = startWord;
+        int rowLo = sr + 1, rowHi = sr + 1;     // Padded rows holding the frontier
+        touchedLo = touchedHi = sr + 1;
+        long long reached = 1;
+        int level = 0;
+        bool found = (sr == er && sc == ec);
+
+        while (!found && rowLo <= rowHi) {
+
+            level++;
+            int newRowLo = INT_MAX, newRowHi = -1;
+            int firstRow = rowLo - 1 > 1 ? rowLo - 1 : 1;
+            int lastRow = rowHi + 1 < rows ? rowHi + 1 : rows;
+
+            for (int pr = firstRow; pr <= lastRow; pr++) {
+
+                // Words that can receive cells: the row's own frontier widened
+                // by one word, plus the frontier words directly above and below
+                int lo = INT_MAX, hi = -1;
+                if (frontHi[pr] >= 0) {
+                    lo = frontLo[pr] - 1;
+                    hi = frontHi[pr] + 1;
+                }
+                if (frontHi[pr - 1] >= 0) {
+                    if (frontLo[pr - 1] < lo) lo = frontLo[pr - 1];
+                    if (frontHi[pr - 1] > hi) hi = frontHi[pr - 1];
+                }
+                if (frontHi[pr + 1] >= 0) {
+                    if (frontLo[pr + 1] < lo) lo = frontLo[pr + 1];
+                    if (frontHi[pr + 1] > hi) hi = frontHi[pr + 1];
+                }
+                if (hi < 0) continue;
+                if (lo < 1) lo = 1;
+                if (hi > rowWords) hi = rowWords;
+
+                int foundLo = INT_MAX, foundHi = -1;
+                expandRow(pr, lo, hi, level, foundLo, foundHi, reached);
+                if (foundHi >= 0) {
+                    nextLo[pr] = foundLo;
+                    nextHi[pr] = foundHi;
+                    if (pr < newRowLo) newRowLo = pr;
+                    if (pr > newRowHi) newRowHi = pr;
+                }
+
+                // The row above is no longer needed; clear it so the old
+                // frontier can be reused as the next buffer
+                clearFrontierRow(pr - 1);
+            }
+            clearFrontierRow(lastRow);
+
+            unsigned long long* tmpMap = frontier;
+            frontier = next;
+            next = tmpMap;
+            int* tmpRange = frontLo;
+            frontLo = nextLo;
+            nextLo = tmpRange;
+            tmpRange = frontHi;
+            frontHi = nextHi;
+            nextHi = tmpRange;
+            rowLo = newRowLo;
+            rowHi = newRowHi;
+            if (rowHi >= 0 && rowLo < touchedLo) touchedLo = rowLo;
+            if (rowHi > touchedHi) touchedHi = rowHi;
+
+            found = testBit(frontier, er, ec);
+        }
+
+        nodesVisited = reached > INT_MAX ? INT_MAX : (int)reached;
+        if (!found) return false;
+
+        // Walk back from E, each step to a neighbor one level closer to S
+        int dr[] = {0, 0, 1, -1};
+        int dc[] = {1, -1, 0, 0};
+        int r = er, c = ec;
+        pathLen = level + 1;
+        path[level] = r * cols + c;
+        for (int l = level - 1; l >= 0; l--) {
+            for (int d = 0; d < 4; d++) {
+                int nr = r + dr[d], nc = c + dc[d];
+                if (nr < 0 || nr >= rows || nc < 0 || nc >= cols) continue;
+                if (testBit(visited, nr, nc) && levelMod3(nr, nc) == l % 3) {
+                    r = nr;
+                    c = nc;
+                    break;
+                }
+            }
+            path[l] = r * cols + c;
+        }
+
+        return true;
+
+    }
+
+    ~BitParallelBFS() {
+
+        delete[] open;
+        delete[] visited;
+        delete[] frontier;
+        delete[] next;
+        delete[] levelLow;
+        delete[] levelHigh;
+        delete[] frontLo;
+        delete[] frontHi;
+        delete[] nextLo;
+        delete[] nextHi;
+
+    }
+};
+
+// ==================== CORRIDOR CONTRACTION ====================
+// PURPOSE: Smaller graph with nodes only where a search has a choice to make
+// An open cell with exactly two open neighbors is a corridor cell: a path that
+// enters it can only leave the other way. Every other open cell (junctions and
+// dead ends), plus S and E, is a key cell. Key cells are the nodes, and each
+// corridor between two key cells becomes one edge weighted by the total entry
+// cost of its cells.
+// Dead-end filling can run first. It repeatedly walls up open cells with at
+// most one open neighbor (except S and E), which leaves only cells that lie on
+// some S-E path, so the result is only valid for the S-E query.
+// Each edge stores its first step and its length, so a path is expanded back
+// into cells by walking the corridor again.
+// USED IN: MazeSolver::solveContracted
+
+class CorridorGraph {
+
+private:
+    GridGraph* grid;
+    bool* filled;            // Cells removed by dead-end filling, NULL without it
+    int offsets[MAX_DEGREE]; // Grid id step right, left, down, up
+    int keyCount, edgeCount;
+    int* keyCells;           // Grid id of each key cell
+    int* edgeBegin;          // Edges of key k are edgeBegin[k] .. edgeBegin[k+1]-1
+    int* edgeDest;
+    long long* edgeCost;
+    int* edgeSteps;          // Cells entered along the edge
+    unsigned char* edgeDir;  // Index into offsets of the edge's first step
+    int startKey, endKey;
+
+    bool isLive(int cell) {
+
+        return grid->isOpen(cell) && (filled == NULL || !filled[cell]);
+
+    }
+
+    int liveDegree(int cell) {
+
+        int degree = 0;
+        for (int d = 0; d < MAX_DEGREE; d++) {
+            if (isLive(cell + offsets[d])) degree++;
+        }
+        return degree;
+
+    }
+
+    int cellIndex(int cell) {
+
+        // PURPOSE: row * cols + col of a grid id, the form paths are returned in
+        int r, c;
+        grid->getNodeCoords(cell, r, c);
+        return r * (grid->getStride() - 2) + c;
+
+    }
+
+    int nextCorridorCell(int cell, int prev) {
+
+        // PURPOSE: The way on out of a corridor cell entered from prev
+        for (int d = 0; d < MAX_DEGREE; d++) {
+            int next = cell + offsets[d];
+            if (next != prev && isLive(next)) return next;
+        }
+        return -1;
+
+    }
+
+    void fillDeadEnds(int startCell, int endCell) {
+
+        int nodeSpace = grid->getNodeSpace();
+        filled = new bool[nodeSpace]();
+        unsigned char* degree = new unsigned char[nodeSpace]();
+        int* stack = new int[grid->getOpenCount() + 1];
+        int top = 0;
+
+        for (int cell = 0; cell < nodeSpace; cell++) {
+            if (!grid->isOpen(cell)) continue;
+            degree[cell] = (unsigned char)liveDegree(cell);
+            if (degree[cell] <= 1 && cell != startCell && cell != endCell) stack[top++] = cell;
+        }
+
+        // A cell is pushed when its degree first drops to one, so at most once
+        while (top > 0) {
+            int cell = stack[--top];
+            filled[cell] = true;
+            for (int d = 0; d < MAX_DEGREE; d++) {
+                int next = cell + offsets[d];
+                if (!isLive(next)) continue;
+                degree[next]--;
+                if (degree[next] == 1 && next != startCell && next != endCell) stack[top++] = next;
+            }
+        }
+
+        delete[] degree;
+        delete[] stack;
+
+    }
+
+public:
+
+    CorridorGraph(GridGraph* g, int startCell, int endCell, bool fillDeadEndsFirst) : grid(g), filled(NULL),
+        keyCount(0), edgeCount(0), startKey(-1), endKey(-1) {
+
+        int stride = grid->getStride();
+        offsets[0] = 1;
+        offsets[1] = -1;
+        offsets[2] = stride;
+        offsets[3] = -stride;
+
+        if (fillDeadEndsFirst) fillDeadEnds(startCell, endCell);
+
+        // Number the key cells in grid order and count their edges
+        int nodeSpace = grid->getNodeSpace();
+        int* keyOf = new int[nodeSpace];
+        long long edgeTotal = 0;
+        for (int cell = 0; cell < nodeSpace; cell++) {
+            keyOf[cell] = -1;
+            if (!isLive(cell)) continue;
+            int degree = liveDegree(cell);
+            if (degree != 2 || cell == startCell || cell == endCell) {
+                keyOf[cell] = keyCount++;
+                edgeTotal += degree;
+            }
+        }
+        edgeCount = (int)edgeTotal;    // At most MAX_DEGREE per key cell, each an open cell
+
+        keyCells = new int[keyCount > 0 ? keyCount : 1];
+        edgeBegin = new int[keyCount + 1];
+        edgeDest = new int[edgeCount > 0 ? edgeCount : 1];
+        edgeCost = new long long[edgeCount > 0 ? edgeCount : 1];
+        edgeSteps = new int[edgeCount > 0 ? edgeCount : 1];
+        edgeDir = new unsigned char[edgeCount > 0 ? edgeCount : 1];
+
+        // Walk every corridor leaving every key cell
+        int edge = 0;
+        for (int cell = 0; cell < nodeSpace; cell++) {
+            int key = keyOf[cell];
+            if (key == -1) continue;
+
+            keyCells[key] = cell;
+            edgeBegin[key] = edge;
+            for (int d = 0; d < MAX_DEGREE; d++) {
+                int prev = cell;
+                int curr = cell + offsets[d];
+                if (!isLive(curr)) continue;
+
+                long long cost = grid->getCost(curr);
+                int steps = 1;
+                while (keyOf[curr] == -1) {
+                    int next = nextCorridorCell(curr, prev);
+                    prev = curr;
+                    curr = next;
+                    cost += grid->getCost(curr);
+                    steps++;
+                }
+
+                edgeDest[edge] = keyOf[curr];
+                edgeCost[edge] = cost;
+                edgeSteps[edge] = steps;
+                edgeDir[edge] = (unsigned char)d;
+                edge++;
+            }
+        }
+        edgeBegin[keyCount] = edge;
+
+        startKey = keyOf[startCell];
+        endKey = keyOf[endCell];
+        delete[] keyOf;
+
+    }
+
+    int getKeyCount() {
+
+        return keyCount;
+
+    }
+
+    int getEdgeCount() {
+
+        return edgeCount;
+
+    }
+
+    bool solve(int path[], int& pathLen, int& nodesVisited) {
+
+        // PURPOSE: Dijkstra from S to E over key cells, then expand the corridors
+        pathLen = 0;
+        nodesVisited = 0;
+        if (startKey == -1 || endKey == -1) return false;
+
+        long long* dist = new long long[keyCount];
+        int* parentEdge = new int[keyCount];
+        int* parentKey = new int[keyCount];
+        bool* settled = new bool[keyCount]();
+        for (int k = 0; k < keyCount; k++) {
+            dist[k] = LLONG_MAX;
+            parentEdge[k] = -1;
+            parentKey[k] = -1;
+        }
+
+        IndexedMinHeap open(keyCount);
+        dist[startKey] = 0;
+        open.push(startKey, 0);
+        bool found = false;
+
+        while (!open.isEmpty()) {
+
+            int curr = open.popMin();
+            settled[curr] = true;
+            nodesVisited++;
+
+            if (curr == endKey) {
+                found = true;
+                break;
+            }
+
+            for (int e = edgeBegin[curr]; e < edgeBegin[curr + 1]; e++) {
+                int next = edgeDest[e];
+                if (settled[next]) continue;
+
+                long long newDist = dist[curr] + edgeCost[e];
+                if (newDist < dist[next]) {
+                    dist[next] = newDist;
+                    parentEdge[next] = e;
+                    parentKey[next] = curr;
+                    open.push(next, newDist);
+                }
+            }
+        }
+
+        if (found) {
+
+            pathLen = 1;
+            for (int k = endKey; parentEdge[k] != -1; k = parentKey[k]) pathLen += edgeSteps[parentEdge[k]];
+
+            // Re-walk each corridor from its start, filling the path from the back
+            int index = pathLen - 1;
+            for (int k = endKey; parentEdge[k] != -1; k = parentKey[k]) {
+                int e = parentEdge[k];
+                int steps = edgeSteps[e];
+                int prev = keyCells[parentKey[k]];
+                int curr = prev + offsets[edgeDir[e]];
+                for (int i = 0; i < steps; i++) {
+                    if (i > 0) {
+                        int next = nextCorridorCell(curr, prev);
+                        prev = curr;
+                        curr = next;
+                    }
+                    path[index - steps + 1 + i] = cellIndex(curr);
+                }
+                index -= steps;
+            }
+            path[0] = cellIndex(keyCells[startKey]);
+
+        }
+
+        delete[] dist;
+        delete[] parentEdge;
+        delete[] parentKey;
+        delete[] settled;
+        return found;
+
+    }
+
+    ~CorridorGraph() {
+
+        delete[] filled;
+        delete[] keyCells;
+        delete[] edgeBegin;
+        delete[] edgeDest;
+        delete[] edgeCost;
+        delete[] edgeSteps;
+        delete[] edgeDir;
+
+    }
 };
 
 // ==================== SORTING ALGORITHMS ====================
 void bubbleSort(double arr[], int n) {
 
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            if (arr[j] > arr[j + 1]) {
-                double temp = arr[j];
-                arr[j] = arr[j + 1];
-                arr[j + 1] = temp;
-            }
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - i - 1; j++) {
+            if (arr[j] > arr[j + 1]) {
+                double temp = arr[j];
+                arr[j] = arr[j + 1];
+                arr[j + 1] = temp;
+            }
+        }
+    }
+
+}
+
+void insertionSort(int arr[], int n) {
+
+    for (int i = 1; i < n; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        while (j >= 0 && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+
+    }
+}
+
+void mergeSort(double arr[], int n) {
+
+    // PURPOSE: O(n log n) sort for inputs too large for the quadratic sorts
+    // USED IN: Latency percentiles of batch queries
+    if (n < 2) return;
+    double* temp = new double[n];
+    for (int width = 1; width < n; width *= 2) {
+        for (int lo = 0; lo < n - width; lo += 2 * width) {
+            int mid = lo + width;
+            int hi = (mid + width < n) ? mid + width : n;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) temp[k++] = (arr[j] < arr[i]) ? arr[j++] : arr[i++];
+            while (i < mid) temp[k++] = arr[i++];
+            while (j < hi) temp[k++] = arr[j++];
+            for (k = lo; k < hi; k++) arr[k] = temp[k];
+        }
+    }
+    delete[] temp;
+
+}
+
+double percentile(double sorted[], int n, double p) {
+
+    // PURPOSE: Nearest-rank percentile of an ascending array
+    if (n == 0) return 0;
+    int rank = (int)ceil(p / 100.0 * n);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+
+}
+
+void radixSortByKey(unsigned long long keys[], int values[], int n) {
+
+    // PURPOSE: Stable sort of values (and keys) by 64-bit key, LSD radix one byte at a time
+    // A pass is skipped when every key has the same byte there, so keys that
+    // only use their low bits (like interleaved grid coordinates) take few passes
+    unsigned long long* keyTemp = new unsigned long long[n > 0 ? n : 1];
+    int* valueTemp = new int[n > 0 ? n : 1];
+    unsigned long long* keyFrom = keys;
+    int* valueFrom = values;
+    unsigned long long* keyTo = keyTemp;
+    int* valueTo = valueTemp;
+
+    for (int shift = 0; shift < 64 && n > 1; shift += 8) {
+
+        int start[257];
+        memset(start, 0, sizeof(start));
+        for (int i = 0; i < n; i++) start[((keyFrom[i] >> shift) & 0xFF) + 1]++;
+        if (start[((keyFrom[0] >> shift) & 0xFF) + 1] == n) continue;
+
+        for (int b = 0; b < 256; b++) start[b + 1] += start[b];
+        for (int i = 0; i < n; i++) {
+            int slot = start[(keyFrom[i] >> shift) & 0xFF]++;
+            keyTo[slot] = keyFrom[i];
+            valueTo[slot] = valueFrom[i];
+        }
+
+        unsigned long long* keySwap = keyFrom;
+        keyFrom = keyTo;
+        keyTo = keySwap;
+        int* valueSwap = valueFrom;
+        valueFrom = valueTo;
+        valueTo = valueSwap;
+
+    }
+
+    if (keyFrom != keys) {
+        memcpy(keys, keyFrom, sizeof(unsigned long long) * (size_t)n);
+        memcpy(values, valueFrom, sizeof(int) * (size_t)n);
+    }
+
+    delete[] keyTemp;
+    delete[] valueTemp;
+
+}
+
+// ==================== HIERARCHICAL PATHFINDING ====================
+// PURPOSE: HPA* - search a coarse graph of cluster entrances, then only the
+// clusters on the route it finds
+// The grid is cut into clusterSize x clusterSize clusters. Where two
+// neighboring clusters share a stretch of open cells along their border, one
+// transition joins them (two, one at each end, once the stretch is
+// HPA_WIDE_ENTRANCE cells or wider). The cells of the transitions are the
+// entrance nodes; a transition is an edge between the two clusters, and inside
+// a cluster every pair of its entrances that can reach each other gets an edge
+// weighted by the cheapest path within the cluster.
+// A query links S and E to the entrances of their own clusters, runs A* over
+// the entrance graph, and turns each edge of the route back into cells with a
+// search confined to one cluster. Paths can only change cluster at a
+// transition, so on open ground they may be slightly longer than the shortest;
+// through one-cell openings, as in generated mazes, they are exact.
+// USED IN: MazeSolver::solveHierarchical
+
+const int DEFAULT_CLUSTER_SIZE = 32;
+const int HPA_WIDE_ENTRANCE = 6;
+
+class HierarchicalGraph {
+
+private:
+    GridGraph* grid;
+    bool unitCost;           // Every cell costs 1, so cluster searches can be plain BFS
+    int rows, cols;
+    int clusterSize;
+    int clusterRows, clusterCols;
+    int nodeCount, edgeCount, transitionCount;
+    int* nodeCell;           // Grid id of each entrance, grouped by cluster, in grid order within one
+    int* clusterBegin;       // Entrances of cluster k are clusterBegin[k] .. clusterBegin[k+1]-1
+    int* edgeBegin;          // Edges of entrance n are edgeBegin[n] .. edgeBegin[n+1]-1
+    int* edgeDest;
+    int* edgeCost;
+    int maxClusterNodes;
+
+    // Search inside one cluster, indexed by (row % clusterSize) * clusterSize + col % clusterSize
+    int* localDist;
+    int* localParent;        // Grid id of the cell each cell was reached from
+    unsigned int* localStamp;
+    unsigned int localGeneration;
+    int* localQueue;
+    IndexedMinHeap* localHeap;
+    long long localExpanded; // Cells expanded by cluster searches
+
+    // Search over the entrances; S is node nodeCount and E is nodeCount + 1
+    int* abstractDist;
+    int* abstractParent;
+    unsigned int* abstractStamp;
+    unsigned int abstractGeneration;
+    IndexedMinHeap* abstractHeap;
+    int abstractVisited;     // Entrances expanded by the last query
+    int* startEdgeDest;      // Edges from S: its cluster's entrances, and E when it shares the cluster
+    int* startEdgeCost;
+    int* goalCost;           // Cost from each entrance of E's cluster to E, -1 if none
+
+    int clusterOf(int cell) {
+
+        int r, c;
+        grid->getNodeCoords(cell, r, c);
+        return r / clusterSize * clusterCols + c / clusterSize;
+
+    }
+
+    int localIndex(int cell) {
+
+        int r, c;
+        grid->getNodeCoords(cell, r, c);
+        return r % clusterSize * clusterSize + c % clusterSize;
+
+    }
+
+    int cellIndex(int cell) {
+
+        // PURPOSE: row * cols + col of a grid id, the form paths are returned in
+        int r, c;
+        grid->getNodeCoords(cell, r, c);
+        return r * cols + c;
+
+    }
+
+    int nodeOf(int cell) {
+
+        // PURPOSE: Entrance node at cell (binary search in its cluster), or -1
+        int k = clusterOf(cell);
+        int lo = clusterBegin[k], hi = clusterBegin[k + 1] - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (nodeCell[mid] == cell) return mid;
+            if (nodeCell[mid] < cell) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -1;
+
+    }
+
+    int localDistance(int cell) {
+
+        // PURPOSE: Cost found by the last cluster search, or -1 if it did not reach cell
+        int i = localIndex(cell);
+        return localStamp[i] == localGeneration ? localDist[i] : -1;
+
+    }
+
+    void searchCluster(int cluster, int source, int target, bool reverse) {
+
+        // PURPOSE: Cheapest paths from source to the cells of its cluster, never
+        // leaving it; stops once target (unless -1) is settled.
+        // reverse gives the cost from each cell to source instead: a move costs
+        // the cell it enters, so walking backwards it costs the cell it leaves.
+        localGeneration++;
+        if (localGeneration == 0) {
+            for (int i = 0; i < clusterSize * clusterSize; i++) localStamp[i] = 0;
+            localGeneration = 1;
+        }
+
+        int rowLo = cluster / clusterCols * clusterSize;
+        int colLo = cluster % clusterCols * clusterSize;
+        int height = rows - rowLo < clusterSize ? rows - rowLo : clusterSize;
+        int width = cols - colLo < clusterSize ? cols - colLo : clusterSize;
+        int stride = grid->getStride();
+        int base = grid->nodeAt(rowLo, colLo);
+        int localStep[MAX_DEGREE] = {1, -1, clusterSize, -clusterSize};
+        int gridStep[MAX_DEGREE] = {1, -1, stride, -stride};
+
+        int s = localIndex(source);
+        localStamp[s] = localGeneration;
+        localDist[s] = 0;
+        localParent[s] = -1;
+        int head = 0, tail = 0;
+        if (unitCost) localQueue[tail++] = s;
+        else localHeap->push(s, 0);
+
+        while (unitCost ? head < tail : !localHeap->isEmpty()) {
+
+            int i = unitCost ? localQueue[head++] : localHeap->popMin();
+            int lr = i / clusterSize;
+            int lc = i - lr * clusterSize;
+            int curr = base + lr * stride + lc;
+            localExpanded++;
+            if (curr == target) break;
+
+            // Right, left, down, up, as GridGraph::getNeighbors, without leaving the cluster
+            bool inside[MAX_DEGREE] = {lc + 1 < width, lc > 0, lr + 1 < height, lr > 0};
+            for (int k = 0; k < MAX_DEGREE; k++) {
+                int next = curr + gridStep[k];
+                if (!inside[k] || !grid->isOpen(next)) continue;
+
+                int j = i + localStep[k];
+                int d = localDist[i] + grid->getCost(reverse ? curr : next);
+                bool seen = localStamp[j] == localGeneration;
+                if (seen && d >= localDist[j]) continue;
+
+                localStamp[j] = localGeneration;
+                localDist[j] = d;
+                localParent[j] = curr;
+                if (!unitCost) localHeap->push(j, d);
+                else if (!seen) localQueue[tail++] = j;
+            }
+        }
+        if (!unitCost) localHeap->clear();
+
+    }
+
+    bool appendClusterPath(int from, int to, int path[], int capacity, int& pathLen) {
+
+        // PURPOSE: Add the cells after from up to to (same cluster) to path;
+        // false if they do not fit
+        searchCluster(clusterOf(from), from, to, false);
+        int steps = 0;
+        for (int cell = to; cell != from; cell = localParent[localIndex(cell)]) steps++;
+        if (pathLen + steps > capacity) return false;
+
+        int index = pathLen + steps - 1;
+        for (int cell = to; cell != from; cell = localParent[localIndex(cell)]) path[index--] = cellIndex(cell);
+        pathLen += steps;
+        return true;
+
+    }
+
+    void addTransition(int*& cells, int& capacity, int a, int b) {
+
+        if (2 * transitionCount + 2 > capacity) {
+            int* bigger = new int[capacity * 2];
+            for (int i = 0; i < 2 * transitionCount; i++) bigger[i] = cells[i];
+            delete[] cells;
+            cells = bigger;
+            capacity *= 2;
+        }
+        cells[2 * transitionCount] = a;
+        cells[2 * transitionCount + 1] = b;
+        transitionCount++;
+
+    }
+
+    void addEntrance(int*& cells, int& capacity, int aRow, int aCol, int bRow, int bCol, int first, int last) {
+
+        // PURPOSE: Transitions for one open stretch of a border; cell i of the
+        // stretch is (aRow, aCol) + i * (step along the border) on one side
+        // and the same from (bRow, bCol) on the other
+        int rowStep = aRow == bRow ? 1 : 0;
+        int colStep = 1 - rowStep;
+        int picks[2] = {(first + last) / 2, last};
+        int pickCount = 1;
+        if (last - first + 1 >= HPA_WIDE_ENTRANCE) {
+            picks[0] = first;
+            pickCount = 2;
+        }
+        for (int p = 0; p < pickCount; p++) {
+            int i = picks[p];
+            addTransition(cells, capacity, grid->nodeAt(aRow + i * rowStep, aCol + i * colStep),
+                          grid->nodeAt(bRow + i * rowStep, bCol + i * colStep));
+        }
+
+    }
+
+public:
+
+    HierarchicalGraph(GridGraph* g, int rowCount, int colCount, int size, bool unitCosts) : grid(g),
+        unitCost(unitCosts), rows(rowCount), cols(colCount), clusterSize(size > 1 ? size : 2),
+        nodeCount(0), edgeCount(0), transitionCount(0), maxClusterNodes(0), localGeneration(0),
+        localExpanded(0), abstractGeneration(0), abstractVisited(0) {
+
+        clusterRows = (rows + clusterSize - 1) / clusterSize;
+        clusterCols = (cols + clusterSize - 1) / clusterSize;
+        int clusterCount = clusterRows * clusterCols;
+        int area = clusterSize * clusterSize;
+        localDist = new int[area];
+        localParent = new int[area];
+        localStamp = new unsigned int[area]();
+        localQueue = new int[area];
+        localHeap = new IndexedMinHeap(area);
+
+        // Transitions across every horizontal border, then every vertical one;
+        // a stretch never runs past the end of the cluster pair it joins
+        int capacity = 1024;
+        int* transitions = new int[capacity];
+        for (int r = clusterSize; r < rows; r += clusterSize) {
+            for (int c0 = 0; c0 < cols; c0 += clusterSize) {
+                int c1 = c0 + clusterSize < cols ? c0 + clusterSize : cols;
+                int first = -1;
+                for (int c = c0; c <= c1; c++) {
+                    bool open = c < c1 && grid->isOpen(grid->nodeAt(r - 1, c)) && grid->isOpen(grid->nodeAt(r, c));
+                    if (open && first == -1) first = c - c0;
+                    if (!open && first != -1) {
+                        addEntrance(transitions, capacity, r - 1, c0, r, c0, first, c - c0 - 1);
+                        first = -1;
+                    }
+                }
+            }
+        }
+        for (int c = clusterSize; c < cols; c += clusterSize) {
+            for (int r0 = 0; r0 < rows; r0 += clusterSize) {
+                int r1 = r0 + clusterSize < rows ? r0 + clusterSize : rows;
+                int first = -1;
+                for (int r = r0; r <= r1; r++) {
+                    bool open = r < r1 && grid->isOpen(grid->nodeAt(r, c - 1)) && grid->isOpen(grid->nodeAt(r, c));
+                    if (open && first == -1) first = r - r0;
+                    if (!open && first != -1) {
+                        addEntrance(transitions, capacity, r0, c - 1, r0, c, first, r - r0 - 1);
+                        first = -1;
+                    }
+                }
+            }
+        }
+
+        // Entrances: the distinct transition cells, sorted by cluster and then grid id
+        int cellTotal = 2 * transitionCount;
+        unsigned long long* keys = new unsigned long long[cellTotal > 0 ? cellTotal : 1];
+        int* order = new int[cellTotal > 0 ? cellTotal : 1];
+        for (int i = 0; i < cellTotal; i++) {
+            keys[i] = ((unsigned long long)clusterOf(transitions[i]) << 32) | (unsigned int)transitions[i];
+            order[i] = i;
+        }
+        radixSortByKey(keys, order, cellTotal);
+
+        nodeCell = new int[cellTotal > 0 ? cellTotal : 1];
+        clusterBegin = new int[clusterCount + 1]();
+        for (int i = 0; i < cellTotal; i++) {
+            if (i > 0 && keys[i] == keys[i - 1]) continue;
+            nodeCell[nodeCount++] = (int)(keys[i] & 0xFFFFFFFFULL);
+            clusterBegin[(keys[i] >> 32) + 1]++;
+        }
+        for (int k = 0; k < clusterCount; k++) {
+            if (clusterBegin[k + 1] > maxClusterNodes) maxClusterNodes = clusterBegin[k + 1];
+            clusterBegin[k + 1] += clusterBegin[k];
+        }
+        delete[] keys;
+        delete[] order;
+
+        // Edges: one each way per transition, and one per ordered pair of
+        // entrances of a cluster that can reach each other inside it. Room is
+        // made for every pair, then the unreachable ones are squeezed out.
+        edgeBegin = new int[nodeCount + 1]();
+        for (int t = 0; t < 2 * transitionCount; t++) edgeBegin[nodeOf(transitions[t]) + 1]++;
+        for (int k = 0; k < clusterCount; k++) {
+            for (int n = clusterBegin[k]; n < clusterBegin[k + 1]; n++) {
+                edgeBegin[n + 1] += clusterBegin[k + 1] - clusterBegin[k] - 1;
+            }
+        }
+        for (int n = 0; n < nodeCount; n++) edgeBegin[n + 1] += edgeBegin[n];
+        int edgeRoom = edgeBegin[nodeCount];
+        edgeDest = new int[edgeRoom > 0 ? edgeRoom : 1];
+        edgeCost = new int[edgeRoom > 0 ? edgeRoom : 1];
+
+        int* fill = new int[nodeCount > 0 ? nodeCount : 1];
+        for (int n = 0; n < nodeCount; n++) fill[n] = edgeBegin[n];
+        for (int t = 0; t < transitionCount; t++) {
+            int a = transitions[2 * t], b = transitions[2 * t + 1];
+            int na = nodeOf(a), nb = nodeOf(b);
+            edgeDest[fill[na]] = nb;
+            edgeCost[fill[na]++] = grid->getCost(b);
+            edgeDest[fill[nb]] = na;
+            edgeCost[fill[nb]++] = grid->getCost(a);
+        }
+        for (int k = 0; k < clusterCount; k++) {
+            for (int n = clusterBegin[k]; n < clusterBegin[k + 1]; n++) {
+                searchCluster(k, nodeCell[n], -1, false);
+                for (int m = clusterBegin[k]; m < clusterBegin[k + 1]; m++) {
+                    int d = m != n ? localDistance(nodeCell[m]) : -1;
+                    if (d < 0) continue;
+                    edgeDest[fill[n]] = m;
+                    edgeCost[fill[n]++] = d;
+                }
+            }
+        }
+        for (int n = 0; n < nodeCount; n++) {
+            int from = edgeBegin[n];
+            edgeBegin[n] = edgeCount;
+            for (int e = from; e < fill[n]; e++) {
+                edgeDest[edgeCount] = edgeDest[e];
+                edgeCost[edgeCount++] = edgeCost[e];
+            }
+        }
+        edgeBegin[nodeCount] = edgeCount;
+        delete[] fill;
+        delete[] transitions;
+
+        abstractDist = new int[nodeCount + 2];
+        abstractParent = new int[nodeCount + 2];
+        abstractStamp = new unsigned int[nodeCount + 2]();
+        abstractHeap = new IndexedMinHeap(nodeCount + 2);
+        startEdgeDest = new int[maxClusterNodes + 1];
+        startEdgeCost = new int[maxClusterNodes + 1];
+        goalCost = new int[maxClusterNodes > 0 ? maxClusterNodes : 1];
+
+    }
+
+    int getClusterSize() {
+
+        return clusterSize;
+
+    }
+
+    int getClusterCount() {
+
+        return clusterRows * clusterCols;
+
+    }
+
+    int getNodeCount() {
+
+        return nodeCount;
+
+    }
+
+    int getEdgeCount() {
+
+        return edgeCount;
+
+    }
+
+    long long getBytes() {
+
+        // PURPOSE: Memory of the entrance graph and both searches' scratch
+        long long area = (long long)clusterSize * clusterSize;
+        long long intBytes = (long long)sizeof(int);
+        return (long long)nodeCount * (intBytes * 4 + (long long)sizeof(unsigned int)) +
+            (long long)edgeCount * intBytes * 2 + (long long)(getClusterCount() + 1) * intBytes +
+            area * (intBytes * 3 + (long long)sizeof(unsigned int)) + (long long)maxClusterNodes * intBytes * 3;
+
+    }
+
+    int getLastAbstractVisited() {
+
+        // PURPOSE: Entrances the last query expanded (the rest of its nodesVisited are cells)
+        return abstractVisited;
+
+    }
+
+    // Path from startCell to endCell (grid ids) as row * cols + col cells;
+    // path needs room for capacity cells. nodesVisited counts entrances expanded
+    // plus cells expanded by the cluster searches.
+    bool solve(int startCell, int endCell, int path[], int capacity, int& pathLen, int& nodesVisited) {
+
+        pathLen = 0;
+        nodesVisited = 0;
+        abstractVisited = 0;
+        localExpanded = 0;
+        int startCluster = clusterOf(startCell);
+        int goalCluster = clusterOf(endCell);
+        int sourceNode = nodeCount, goalNode = nodeCount + 1;
+
+        // Link S to its cluster's entrances (and to E if they share it)
+        int startEdges = 0;
+        searchCluster(startCluster, startCell, -1, false);
+        for (int n = clusterBegin[startCluster]; n < clusterBegin[startCluster + 1]; n++) {
+            int d = localDistance(nodeCell[n]);
+            if (d < 0) continue;
+            startEdgeDest[startEdges] = n;
+            startEdgeCost[startEdges++] = d;
+        }
+        if (startCluster == goalCluster && localDistance(endCell) >= 0) {
+            startEdgeDest[startEdges] = goalNode;
+            startEdgeCost[startEdges++] = localDistance(endCell);
+        }
+
+        // And E's cluster's entrances to E
+        searchCluster(goalCluster, endCell, -1, true);
+        int goalFirst = clusterBegin[goalCluster];
+        for (int n = goalFirst; n < clusterBegin[goalCluster + 1]; n++) goalCost[n - goalFirst] = localDistance(nodeCell[n]);
+
+        // A* over the entrances with Manhattan distance between their cells
+        abstractGeneration++;
+        if (abstractGeneration == 0) {
+            for (int n = 0; n < nodeCount + 2; n++) abstractStamp[n] = 0;
+            abstractGeneration = 1;
+        }
+        int endRow, endCol;
+        grid->getNodeCoords(endCell, endRow, endCol);
+        abstractStamp[sourceNode] = abstractGeneration;
+        abstractDist[sourceNode] = 0;
+        abstractParent[sourceNode] = -1;
+        abstractHeap->push(sourceNode, 0);
+        bool found = false;
+
+        while (!abstractHeap->isEmpty()) {
+
+            int curr = abstractHeap->popMin();
+            abstractVisited++;
+            if (curr == goalNode) {
+                found = true;
+                break;
+            }
+
+            int degree = 0;
+            const int* dests;
+            const int* costs;
+            if (curr == sourceNode) {
+                dests = startEdgeDest;
+                costs = startEdgeCost;
+                degree = startEdges;
+            } else {
+                dests = edgeDest + edgeBegin[curr];
+                costs = edgeCost + edgeBegin[curr];
+                degree = edgeBegin[curr + 1] - edgeBegin[curr];
+            }
+
+            // Entrances of E's cluster also lead straight to E
+            bool toGoal = curr != sourceNode && curr >= goalFirst && curr < clusterBegin[goalCluster + 1] &&
+                goalCost[curr - goalFirst] >= 0;
+            for (int k = 0; k <= degree; k++) {
+                int next, d;
+                if (k < degree) {
+                    next = dests[k];
+                    d = abstractDist[curr] + costs[k];
+                } else {
+                    if (!toGoal) break;
+                    next = goalNode;
+                    d = abstractDist[curr] + goalCost[curr - goalFirst];
+                }
+                if (abstractStamp[next] == abstractGeneration && d >= abstractDist[next]) continue;
+
+                abstractStamp[next] = abstractGeneration;
+                abstractDist[next] = d;
+                abstractParent[next] = curr;
+                int r, c;
+                grid->getNodeCoords(next == goalNode ? endCell : nodeCell[next], r, c);
+                int h = (r > endRow ? r - endRow : endRow - r) + (c > endCol ? c - endCol : endCol - c);
+                abstractHeap->push(next, ((long long)(d + h) << 32) | (unsigned int)h);
+            }
+        }
+        abstractHeap->clear();
+
+        // Refine: walk the route from S, filling in the cells of each edge
+        if (found) {
+
+            int routeLen = 0;
+            for (int n = goalNode; n != -1; n = abstractParent[n]) routeLen++;
+            int* route = new int[routeLen];
+            int index = routeLen;
+            for (int n = goalNode; n != -1; n = abstractParent[n]) route[--index] = n;
+
+            path[pathLen++] = cellIndex(startCell);
+            int at = startCell;
+            for (int i = 1; i < routeLen && found; i++) {
+                int next = route[i] == goalNode ? endCell : nodeCell[route[i]];
+                if (clusterOf(at) != clusterOf(next)) {
+                    // A transition: the two cells are neighbors
+                    if (pathLen == capacity) found = false;
+                    else path[pathLen++] = cellIndex(next);
+                } else {
+                    found = appendClusterPath(at, next, path, capacity, pathLen);
+                }
+                at = next;
+            }
+            delete[] route;
+            if (!found) pathLen = 0;
+
+        }
+
+        nodesVisited = abstractVisited + (int)localExpanded;
+        return found;
+
+    }
+
+    ~HierarchicalGraph() {
+
+        delete[] nodeCell;
+        delete[] clusterBegin;
+        delete[] edgeBegin;
+        delete[] edgeDest;
+        delete[] edgeCost;
+        delete[] localDist;
+        delete[] localParent;
+        delete[] localStamp;
+        delete[] localQueue;
+        delete localHeap;
+        delete[] abstractDist;
+        delete[] abstractParent;
+        delete[] abstractStamp;
+        delete abstractHeap;
+        delete[] startEdgeDest;
+        delete[] startEdgeCost;
+        delete[] goalCost;
+
+    }
+};
+
+// ==================== INCREMENTAL REPLANNING ====================
+// PURPOSE: Keep the S-E shortest path current while cells open and close
+// LPA* (Koenig and Likhachev): every cell keeps g, its distance from S as last
+// computed, and rhs, the distance its neighbors' g values give it now. A cell
+// whose two values differ is inconsistent and waits in a priority queue, and
+// planning processes only inconsistent cells, in A* order, until E is
+// consistent and nothing queued could still improve it. The first plan is an
+// ordinary A* search. After that, changing a cell makes only that cell and its
+// neighbors inconsistent, so a replan repairs the part of the previous search
+// the change affects. S and E stay fixed; D* Lite adds the bookkeeping for a
+// start that moves between replans, which nothing here needs.
+// The planner searches its own grid, which cell edits update in place.
+// USED IN: --bench-replan
+
+const int PLANNER_INF = INT_MAX / 2;   // Unknown distance; INF plus a heuristic still fits an int
+
+class IncrementalPlanner {
+
+private:
+    Maze* maze;
+    GridGraph* grid;
+    int offsets[MAX_DEGREE];   // Grid id step right, left, down, up
+    int startCell, endCell;
+    int endRow, endCol;
+    int* g;
+    int* rhs;
+    IndexedMinHeap* open;
+    int expanded;              // Cells processed by the last plan
+
+    long long key(int cell) {
+
+        // PURPOSE: Queue order: min(g, rhs) plus Manhattan distance to E, ties to smaller min(g, rhs)
+        int best = g[cell] < rhs[cell] ? g[cell] : rhs[cell];
+        int r, c;
+        grid->getNodeCoords(cell, r, c);
+        int h = (r > endRow ? r - endRow : endRow - r) + (c > endCol ? c - endCol : endCol - c);
+        return ((long long)(best + h) << 32) | (unsigned int)best;
+
+    }
+
+    void updateCell(int cell) {
+
+        // PURPOSE: Recompute rhs from the neighbors and queue the cell if it is inconsistent
+        if (cell != startCell) {
+            int best = PLANNER_INF;
+            if (grid->isOpen(cell)) {
+                int cost = grid->getCost(cell);
+                int nbrs[MAX_DEGREE];
+                int degree = grid->getNeighbors(cell, nbrs);
+                for (int k = 0; k < degree; k++) {
+                    if (g[nbrs[k]] < PLANNER_INF && g[nbrs[k]] + cost < best) best = g[nbrs[k]] + cost;
+                }
+            }
+            rhs[cell] = best;
+        }
+        open->remove(cell);
+        if (g[cell] != rhs[cell]) open->push(cell, key(cell));
+
+    }
+
+    void computeShortestPath() {
+
+        while (!open->isEmpty() && (open->minKey() < key(endCell) || rhs[endCell] != g[endCell])) {
+
+            int cell = open->popMin();
+            expanded++;
+
+            if (g[cell] > rhs[cell]) {
+                // Better than before: settle it, as A* would
+                g[cell] = rhs[cell];
+            } else {
+                // Worse than before: forget its distance and look at it again
+                g[cell] = PLANNER_INF;
+                updateCell(cell);
+            }
+
+            int nbrs[MAX_DEGREE];
+            int degree = grid->getNeighbors(cell, nbrs);
+            for (int k = 0; k < degree; k++) updateCell(nbrs[k]);
+        }
+
+    }
+
+public:
+
+    IncrementalPlanner(Maze* m) : maze(m), expanded(0) {
+
+        grid = new GridGraph(maze);
+        int stride = grid->getStride();
+        offsets[0] = 1;
+        offsets[1] = -1;
+        offsets[2] = stride;
+        offsets[3] = -stride;
+        startCell = grid->nodeAt(maze->getStartRow(), maze->getStartCol());
+        endCell = grid->nodeAt(maze->getEndRow(), maze->getEndCol());
+        endRow = maze->getEndRow();
+        endCol = maze->getEndCol();
+
+        int nodeSpace = grid->getNodeSpace();
+        g = new int[nodeSpace];
+        rhs = new int[nodeSpace];
+        for (int i = 0; i < nodeSpace; i++) g[i] = rhs[i] = PLANNER_INF;
+        open = new IndexedMinHeap(nodeSpace);
+        rhs[startCell] = 0;
+        open->push(startCell, key(startCell));
+
+    }
+
+    bool setCell(int r, int c, bool makeOpen) {
+
+        // PURPOSE: Open or wall up cell (r, c) in the maze and the planner's
+        // grid; the next plan repairs the path. False for S, E or outside the maze.
+        if (!maze->setOpen(r, c, makeOpen)) return false;
+
+        int cell = grid->nodeAt(r, c);
+        if (grid->isOpen(cell) == makeOpen) return true;
+        grid->setCost(cell, makeOpen ? maze->getCost(r, c) : 0);
+
+        updateCell(cell);
+        for (int d = 0; d < MAX_DEGREE; d++) {
+            if (grid->isOpen(cell + offsets[d])) updateCell(cell + offsets[d]);
+        }
+        return true;
+
+    }
+
+    int getMaxPathLength() {
+
+        // PURPOSE: Size of the path buffer plan needs while the open cells stay as they are
+        return grid->getOpenCount();
+
+    }
+
+    // Bring the search up to date and write the S-E path as row * cols + col
+    // cells. nodesVisited counts the cells processed by this call only.
+    bool plan(int path[], int& pathLen, int& nodesVisited) {
+
+        expanded = 0;
+        computeShortestPath();
+        nodesVisited = expanded;
+        pathLen = 0;
+        if (g[endCell] >= PLANNER_INF) return false;
+
+        // Walk back from E, always to the neighbor closest to S; every cell's entry
+        // cost is the same from any side, so that neighbor is on a shortest path
+        int cols = maze->getCols();
+        int curr = endCell;
+        while (true) {
+            int r, c;
+            grid->getNodeCoords(curr, r, c);
+            path[pathLen++] = r * cols + c;
+            if (curr == startCell) break;
+
+            int nbrs[MAX_DEGREE];
+            int degree = grid->getNeighbors(curr, nbrs);
+            int prev = nbrs[0];
+            for (int k = 1; k < degree; k++) {
+                if (g[nbrs[k]] < g[prev]) prev = nbrs[k];
+            }
+            curr = prev;
+        }
+
+        for (int i = 0, j = pathLen - 1; i < j; i++, j--) {
+            int t = path[i];
+            path[i] = path[j];
+            path[j] = t;
+        }
+        return true;
+
+    }
+
+    ~IncrementalPlanner() {
+
+        delete grid;
+        delete[] g;
+        delete[] rhs;
+        delete open;
+
+    }
+};
+
+// ==================== DISTANCE FIELD ====================
+// PURPOSE: Steps from every cell to its nearest exit, and the first step to take
+// One breadth-first search started from every source at once (the E cells
+// and any extra targets) labels each reachable cell with its distance to the
+// closest source, in the time a single solveBFS takes. Levels are expanded
+// one at a time; a large level is split between threads, which claim cells
+// with compare-and-swap as the parallel BFS does. Each level is queued right
+// after the one before it, so the queue needs one int per open cell.
+// A cell's next hop is its first neighbor (right, left, down, up) one step
+// closer to a source. It is read off the finished distances, so the result
+// is the same for any thread count. Distances count steps; costs are ignored.
+//
+// File layout (sections at 64-byte aligned offsets, machine byte order):
+//   header     - DistanceFileHeader
+//   distances  - rows * cols unsigned values, row-major, distanceBytes each
+//                (2 when every distance fits, else 4); 0 at the sources,
+//                all ones for walls and cells no source reaches
+//   directions - 2 bits per cell, 4 cells per byte from the low bits, each
+//                row padded to directionRowBytes: 0 right, 1 left, 2 down,
+//                3 up. Only meaningful where the distance is above 0.
+// USED IN: --distance-field
+
+const char DISTANCE_FILE_MAGIC[8] = {'M', 'A', 'Z', 'E', 'D', 'I', 'S', 'T'};
+const unsigned int DISTANCE_FILE_VERSION = 1;
+
+struct DistanceFileHeader {
+    char magic[8];
+    unsigned int version;
+    int rows, cols;
+    int sourceCount;           // Open source cells the search started from
+    int maxDistance;           // -1 when there were none
+    int distanceBytes;         // 2 or 4
+    int directionRowBytes;
+    long long reachedCount;    // Cells with a distance, sources included
+    long long distancesOffset;
+    long long directionsOffset;
+    long long fileSize;
+};
+
+class DistanceField {
+
+private:
+    Maze* maze;
+    GridGraph* grid;
+    atomic<int>* dist;           // By grid id; -1 for walls and cells no source reaches
+    unsigned char* directions;   // Next hops, laid out as in the file
+    int directionRowBytes;
+    int sourceCount;
+    long long reachedCount;
+    int maxDistance;
+
+    void computeDirections(int firstRow, int lastRow) {
+
+        // PURPOSE: Fill the next hops of rows firstRow .. lastRow - 1
+        int stride = grid->getStride();
+        int cols = maze->getCols();
+        for (int r = firstRow; r < lastRow; r++) {
+            unsigned char* row = directions + (long long)r * directionRowBytes;
+            memset(row, 0, (size_t)directionRowBytes);
+            int node = grid->nodeAt(r, 0);
+            for (int c = 0; c < cols; c++, node++) {
+                int d = dist[node].load(memory_order_relaxed);
+                if (d <= 0) continue;
+                int dir;
+                if (dist[node + 1].load(memory_order_relaxed) == d - 1) dir = 0;
+                else if (dist[node - 1].load(memory_order_relaxed) == d - 1) dir = 1;
+                else if (dist[node + stride].load(memory_order_relaxed) == d - 1) dir = 2;
+                else dir = 3;
+                row[c >> 2] |= (unsigned char)(dir << ((c & 3) * 2));
+            }
+        }
+
+    }
+
+public:
+
+    DistanceField(Maze* m) : maze(m), sourceCount(0), reachedCount(0), maxDistance(-1) {
+
+        grid = new GridGraph(maze);
+        dist = new atomic<int>[grid->getNodeSpace()];
+        directionRowBytes = (maze->getCols() + 3) / 4;
+        directions = new unsigned char[(long long)maze->getRows() * directionRowBytes];
+
+    }
+
+    // Search from sources (row * cols + col cells; walls and repeats are
+    // skipped) and fill the distances and next hops. pool = NULL runs on the
+    // calling thread. Returns the number of sources used.
+    int compute(const int sources[], int count, ThreadPool* pool) {
+
+        const int CHUNK = 256;
+        const int PARALLEL_THRESHOLD = 4096;
+
+        int nodeSpace = grid->getNodeSpace();
+        for (int i = 0; i < nodeSpace; i++) dist[i].store(-1, memory_order_relaxed);
+
+        int cols = maze->getCols();
+        int* queue = new int[grid->getOpenCount() + 1];
+        int tail = 0;
+        for (int i = 0; i < count; i++) {
+            int node = grid->nodeAt(sources[i] / cols, sources[i] % cols);
+            if (!grid->isOpen(node) || dist[node].load(memory_order_relaxed) != -1) continue;
+            dist[node].store(0, memory_order_relaxed);
+            queue[tail++] = node;
+        }
+        sourceCount = tail;
+
+        int threads = pool != NULL ? pool->getThreadCount() : 1;
+        int** localNext = new int*[threads];
+        int* localSize = new int[threads];
+        int* localCapacity = new int[threads];
+        for (int t = 0; t < threads; t++) {
+            localCapacity[t] = 1024;
+            localNext[t] = new int[localCapacity[t]];
+        }
+
+        int begin = 0, end = tail, level = 0;
+        atomic<int> cursor(0);
+
+        function<void(int)> expand = [&](int t) {
+            localSize[t] = 0;
+            while (true) {
+                int first = begin + cursor.fetch_add(CHUNK);
+                if (first >= end) break;
+                int last = first + CHUNK < end ? first + CHUNK : end;
+
+                for (int i = first; i < last; i++) {
+                    int nbrs[MAX_DEGREE];
+                    int degree = grid->getNeighbors(queue[i], nbrs);
+                    for (int k = 0; k < degree; k++) {
+                        int neighbor = nbrs[k];
+                        if (dist[neighbor].load(memory_order_relaxed) != -1) continue;
+                        int expected = -1;
+                        if (!dist[neighbor].compare_exchange_strong(expected, level + 1)) continue;
+
+                        if (localSize[t] == localCapacity[t]) {
+                            int* grown = new int[localCapacity[t] * 2];
+                            memcpy(grown, localNext[t], sizeof(int) * (size_t)localSize[t]);
+                            delete[] localNext[t];
+                            localNext[t] = grown;
+                            localCapacity[t] *= 2;
+                        }
+                        localNext[t][localSize[t]++] = neighbor;
+                    }
+                }
+            }
+        };
+
+        while (begin < end) {
+
+            if (threads > 1 && end - begin >= PARALLEL_THRESHOLD) {
+                cursor.store(0);
+                pool->run(expand);
+
+                // Append the per-thread buffers as the next level
+                for (int t = 0; t < threads; t++) {
+                    memcpy(queue + tail, localNext[t], sizeof(int) * (size_t)localSize[t]);
+                    tail += localSize[t];
+                }
+            } else {
+                // Small level: no claiming needed on one thread
+                for (int i = begin; i < end; i++) {
+                    int nbrs[MAX_DEGREE];
+                    int degree = grid->getNeighbors(queue[i], nbrs);
+                    for (int k = 0; k < degree; k++) {
+                        if (dist[nbrs[k]].load(memory_order_relaxed) != -1) continue;
+                        dist[nbrs[k]].store(level + 1, memory_order_relaxed);
+                        queue[tail++] = nbrs[k];
+                    }
+                }
+            }
+
+            begin = end;
+            end = tail;
+            level++;
+        }
+
+        reachedCount = tail;
+        maxDistance = level - 1;
+
+        // Next hops, in bands of rows
+        int rows = maze->getRows();
+        if (threads > 1 && (long long)rows * cols >= PARALLEL_THRESHOLD) {
+            pool->run([&](int t) {
+                computeDirections((int)((long long)rows * t / threads), (int)((long long)rows * (t + 1) / threads));
+            });
+        } else {
+            computeDirections(0, rows);
+        }
+
+        for (int t = 0; t < threads; t++) delete[] localNext[t];
+        delete[] localNext;
+        delete[] localSize;
+        delete[] localCapacity;
+        delete[] queue;
+        return sourceCount;
+
+    }
+
+    int getDistance(int r, int c) {
+
+        // PURPOSE: Steps from (r, c) to the nearest source, or -1
+        return dist[grid->nodeAt(r, c)].load(memory_order_relaxed);
+
+    }
+
+    int getDirection(int r, int c) {
+
+        // PURPOSE: Next hop of (r, c): 0 right, 1 left, 2 down, 3 up
+        return (directions[(long long)r * directionRowBytes + (c >> 2)] >> ((c & 3) * 2)) & 3;
+
+    }
+
+    int getSourceCount() {
+
+        return sourceCount;
+
+    }
+
+    long long getReachedCount() {
+
+        return reachedCount;
+
+    }
+
+    int getMaxDistance() {
+
+        return maxDistance;
+
+    }
+
+    bool write(const char* filename, long long& fileSize) {
+
+        // PURPOSE: Save the field in the layout above; fileSize gets the byte count
+        int rows = maze->getRows(), cols = maze->getCols();
+        DistanceFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, DISTANCE_FILE_MAGIC, 8);
+        header.version = DISTANCE_FILE_VERSION;
+        header.rows = rows;
+        header.cols = cols;
+        header.sourceCount = sourceCount;
+        header.maxDistance = maxDistance;
+        header.distanceBytes = maxDistance < 0xFFFF ? 2 : 4;
+        header.directionRowBytes = directionRowBytes;
+        header.reachedCount = reachedCount;
+        header.distancesOffset = alignFileOffset(sizeof(header));
+        long long distanceSize = (long long)rows * cols * header.distanceBytes;
+        header.directionsOffset = alignFileOffset(header.distancesOffset + distanceSize);
+        long long directionSize = (long long)rows * directionRowBytes;
+        header.fileSize = header.directionsOffset + directionSize;
+
+        ofstream out(filename, ios::binary);
+        if (!out.is_open()) {
+            cout << "Error: Cannot write " << filename << endl;
+            return false;
+        }
+
+        long long offset = sizeof(header);
+        out.write((const char*)&header, sizeof(header));
+        padFileTo(out, offset, header.distancesOffset);
+
+        // One row at a time, narrowed to distanceBytes; -1 becomes all ones either way
+        unsigned short* narrow = new unsigned short[cols];
+        unsigned int* wide = new unsigned int[cols];
+        for (int r = 0; r < rows; r++) {
+            int node = grid->nodeAt(r, 0);
+            if (header.distanceBytes == 2) {
+                for (int c = 0; c < cols; c++) narrow[c] = (unsigned short)dist[node + c].load(memory_order_relaxed);
+                out.write((const char*)narrow, (long long)cols * 2);
+            } else {
+                for (int c = 0; c < cols; c++) wide[c] = (unsigned int)dist[node + c].load(memory_order_relaxed);
+                out.write((const char*)wide, (long long)cols * 4);
+            }
+        }
+        delete[] narrow;
+        delete[] wide;
+        offset += distanceSize;
+
+        padFileTo(out, offset, header.directionsOffset);
+        out.write((const char*)directions, directionSize);
+        offset += directionSize;
+
+        out.close();
+        if (out.fail()) {
+            cout << "Error: Failed writing " << filename << endl;
+            return false;
+        }
+
+        fileSize = offset;
+        return true;
+
+    }
+
+    ~DistanceField() {
+
+        delete grid;
+        delete[] dist;
+        delete[] directions;
+
+    }
+};
+
+// ==================== SEARCH WORKSPACE ====================
+// PURPOSE: Per-node search state that is allocated once and reused
+// Every entry carries the generation it was written in. reset() starts a new
+// search by bumping the generation, which invalidates all entries at once,
+// so a search only pays for the nodes it actually touches.
+// USED IN: BFS, DFS and A* (one workspace per thread in batch mode)
+// Once the first search has sized the list pool, later searches make no heap calls
+
+class SearchWorkspace {
+
+private:
+
+    unsigned int* seenStamp;   // Node reached (queued, or gScore valid)
+    unsigned int* doneStamp;   // Node finished (closed in A*)
+    int* parent;               // Valid for seen nodes; the source's is -1
+    int* dist;                 // Valid for seen nodes
+    unsigned int generation;
+    int capacity;
+    IndexedMinHeap* heap;      // Created on first best-first search
+    NodePool<ListNode> listPool;   // Nodes of the search stack/queue, reused across searches
+
+public:
+
+    SearchWorkspace(int nodeCapacity) : generation(0), capacity(nodeCapacity > 0 ? nodeCapacity : 1), heap(NULL) {
+        seenStamp = new unsigned int[capacity]();
+        doneStamp = new unsigned int[capacity]();
+        parent = new int[capacity];
+        dist = new int[capacity];
+    }
+
+    void reset() {
+
+        generation++;
+        if (generation == 0) {
+            // The counter wrapped: old stamps could look current, so clear them once
+            for (int i = 0; i < capacity; i++) {
+                seenStamp[i] = 0;
+                doneStamp[i] = 0;
+            }
+            generation = 1;
+        }
+        if (heap != NULL) heap->clear();
+
+    }
+
+    int getCapacity() {
+
+        return capacity;
+
+    }
+
+    bool isSeen(int node) {
+
+        return seenStamp[node] == generation;
+
+    }
+
+    void markSeen(int node) {
+
+        seenStamp[node] = generation;
+
+    }
+
+    bool isDone(int node) {
+
+        return doneStamp[node] == generation;
+
+    }
+
+    void markDone(int node) {
+
+        doneStamp[node] = generation;
+
+    }
+
+    int* getParents() {
+
+        return parent;
+
+    }
+
+    int* getDist() {
+
+        return dist;
+
+    }
+
+    NodePool<ListNode>* getListPool() {
+
+        return &listPool;
+
+    }
+
+    IndexedMinHeap* getHeap() {
+
+        if (heap == NULL) heap = new IndexedMinHeap(capacity);
+        return heap;
+
+    }
+
+    ~SearchWorkspace() {
+
+        delete[] seenStamp;
+        delete[] doneStamp;
+        delete[] parent;
+        delete[] dist;
+        delete heap;
+
+    }
+};
+
+// ==================== RESUMABLE DFS ====================
+// PURPOSE: State of a depth-first search kept on an explicit frame stack
+// Each frame is a node plus the index of the next neighbor it will try, which is
+// exactly what a recursive call keeps in its locals, so nodes are visited in the
+// same order as the recursive version. A frame is pushed only for a node that has
+// not been seen, so the stack never holds more frames than there are open cells
+// and is allocated once at that size. The search stops after a given number of
+// expansions and carries on from the same frame when resumed.
+// USED IN: MazeSolver::beginDFS / resumeDFS (DFS (Recursive))
+
+const int DFS_PAUSED = 0;      // Expansion budget used up; resume to continue
+const int DFS_FOUND = 1;       // Target reached; its parent chain is the path
+const int DFS_EXHAUSTED = 2;   // Every node reachable from the source was visited
+
+class DFSSearch {
+
+private:
+
+    int* frameNode;              // Node of each frame, the source at the bottom
+    unsigned char* frameNext;    // Next neighbor index each frame will try
+    int capacity;
+    int depth;                   // Frames on the stack
+    int target;
+    int nodesVisited;
+    int status;
+    SearchWorkspace* ws;         // Seen marks and parents of the current search
+
+public:
+
+    DFSSearch(int maxFrames) : capacity(maxFrames > 0 ? maxFrames : 1), depth(0), target(-1),
+        nodesVisited(0), status(DFS_EXHAUSTED), ws(NULL) {
+        frameNode = new int[capacity];
+        frameNext = new unsigned char[capacity];
+    }
+
+    void begin(SearchWorkspace* workspace, int targetNode) {
+
+        ws = workspace;
+        ws->reset();
+        target = targetNode;
+        depth = 0;
+        nodesVisited = 0;
+        status = DFS_PAUSED;
+
+    }
+
+    // Visit node: mark it, count it, and give it a frame unless it is the target
+    void enter(int node, int parent) {
+
+        ws->markSeen(node);
+        ws->getParents()[node] = parent;
+        nodesVisited++;
+
+        if (node == target) {
+
+            status = DFS_FOUND;
+            return;
+
+        }
+
+        frameNode[depth] = node;
+        frameNext[depth] = 0;
+        depth++;
+
+    }
+
+    int getDepth() {
+
+        return depth;
+
+    }
+
+    int topNode() {
+
+        return frameNode[depth - 1];
+
+    }
+
+    int topNext() {
+
+        return frameNext[depth - 1];
+
+    }
+
+    void setTopNext(int next) {
+
+        frameNext[depth - 1] = (unsigned char)next;
+
+    }
+
+    void pop() {
+
+        depth--;
+        if (depth == 0 && status == DFS_PAUSED) status = DFS_EXHAUSTED;
+
+    }
+
+    SearchWorkspace* getWorkspace() {
+
+        return ws;
+
+    }
+
+    int getTarget() {
+
+        return target;
+
+    }
+
+    int getNodesVisited() {
+
+        return nodesVisited;
+
+    }
+
+    int getStatus() {
+
+        return status;
+
+    }
+
+    ~DFSSearch() {
+
+        delete[] frameNode;
+        delete[] frameNext;
+
+    }
+};
+
+// ==================== NODE ORDERING ====================
+// PURPOSE: Choose which open cell gets which graph node id
+// Row-major ids put a cell's vertical neighbors cols ids away, so on wide
+// mazes every step up or down touches another cache line of the per-node
+// arrays. Morton (Z-order) and Hilbert curves number the grid block by block,
+// so most neighbors get nearby ids; Hilbert never jumps between blocks. BFS
+// order numbers cells as a BFS from S reaches them (Cuthill-McKee without
+// the degree sort, since every cell has at most four neighbors).
+// USED IN: MazeSolver::buildGraph, --order, --bench-order
+
+const int NODE_ORDER_ROW_MAJOR = 0;
+const int NODE_ORDER_MORTON = 1;
+const int NODE_ORDER_HILBERT = 2;
+const int NODE_ORDER_BFS = 3;
+const int NODE_ORDER_COUNT = 4;
+
+const char* NODE_ORDER_NAMES[NODE_ORDER_COUNT] = {"rowmajor", "morton", "hilbert", "bfs"};
+
+int findNodeOrder(const char* name) {
+
+    // PURPOSE: Index into NODE_ORDER_NAMES, or -1
+    for (int i = 0; i < NODE_ORDER_COUNT; i++) {
+        if (strcmp(name, NODE_ORDER_NAMES[i]) == 0) return i;
+    }
+    return -1;
+
+}
+
+unsigned long long spreadBits(unsigned int x) {
+
+    // PURPOSE: Move bit i of x to bit 2i
+    unsigned long long v = x;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v << 2)) & 0x3333333333333333ULL;
+    v = (v | (v << 1)) & 0x5555555555555555ULL;
+    return v;
+
+}
+
+unsigned long long mortonKey(int r, int c) {
+
+    return spreadBits((unsigned int)c) | (spreadBits((unsigned int)r) << 1);
+
+}
+
+unsigned long long hilbertKey(int r, int c, int bits) {
+
+    // PURPOSE: Position of (r, c) along a Hilbert curve over a 2^bits square
+    unsigned long long n = 1ULL << bits;
+    unsigned long long x = (unsigned long long)c;
+    unsigned long long y = (unsigned long long)r;
+    unsigned long long d = 0;
+    for (unsigned long long s = n >> 1; s > 0; s >>= 1) {
+        unsigned long long rx = (x & s) ? 1 : 0;
+        unsigned long long ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant so the curve inside it starts and ends in the right corners
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            unsigned long long t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return d;
+
+}
+
+// ==================== SOLVER CLASS ====================
+class MazeSolver {
+private:
+
+    Maze* maze;
+    CSRGraph* graph;
+    CoordIndex* coordMap;
+    GridGraph* grid;       // Set instead of graph/coordMap in implicit-grid mode
+    bool implicitGrid;
+    int startNode, endNode;
+    int threadCount;       // Threads used by the parallel solvers
+    ThreadPool* pool;      // Created on first parallel search
+    SearchWorkspace* workspace;   // Shared by the single-threaded solvers
+    DFSSearch* dfs;               // Frames of DFS (Recursive), built on first use
+    bool ownsGraph;        // False when graph is the one stored with the maze
+    int nodeOrder;         // NODE_ORDER_* numbering of the explicit graph
+    CorridorGraph* corridors;        // Built on first contracted search
+    CorridorGraph* filledCorridors;  // Same, after dead-end filling
+    BitParallelBFS* bitBFS;          // Built on first bit-parallel search
+    LandmarkTable* landmarks;        // Set by buildLandmarks
+    bool ownsLandmarks;              // False when landmarks are the ones stored with the maze
+    HierarchicalGraph* hierarchy;    // Built on first hierarchical search
+    int clusterSize;                 // Cluster side length of the hierarchy
+    long long builtAtEdit;           // maze->getEditCount() when the solver was built
+
+    bool isOpen(char cell) {
+
+        return cell == ' ' || cell == 'S' || cell == 'E' || (cell >= '1' && cell <= '9');
+
+    }
+    
+    void buildGraph() {
+
+        int rows = maze->getRows();
+        int cols = maze->getCols();
+
+        // Count open cells and edges first so every structure is sized exactly once
+        int openCells = 0;
+        long long edgeTotal = 0;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (!isOpen(maze->getCell(i, j))) continue;
+                openCells++;
+                if (isOpen(maze->getCell(i - 1, j))) edgeTotal++;
+                if (isOpen(maze->getCell(i + 1, j))) edgeTotal++;
+                if (isOpen(maze->getCell(i, j - 1))) edgeTotal++;
+                if (isOpen(maze->getCell(i, j + 1))) edgeTotal++;
+            }
+        }
+
+        if (edgeTotal > INT_MAX) {
+            // Edge ids are ints; search the grid itself, which needs no edge list
+            useGrid();
+            return;
+        }
+
+        graph = new CSRGraph(openCells, (int)edgeTotal);
+        coordMap = new CoordIndex(rows, cols, openCells);
+        
+        // Create nodes for all open cells
+        if (nodeOrder == NODE_ORDER_ROW_MAJOR) {
+
+            for (int i = 0; i < rows; i++) {
+
+                for (int j = 0; j < cols; j++) {
+
+                    if (isOpen(maze->getCell(i, j))) {
+
+                        int nodeId = graph->addNode(i, j);
+                        coordMap->insert(i, j, nodeId);
+                    }
+                }
+            }
+
+        } else {
+
+            addNodesInOrder(openCells);
+
+        }
+
+        startNode = coordMap->get(maze->getStartRow(), maze->getStartCol());
+        endNode = coordMap->get(maze->getEndRow(), maze->getEndCol());
+        
+        // Create edges (4-directional) node by node, so each node's edges land
+        // contiguously. Directions are emitted right, left, down, up, which is
+        // the order the solvers have always visited neighbors in.
+        int dr[] = {0, 0, 1, -1};
+        int dc[] = {1, -1, 0, 0};
+        
+        for (int nodeId = 0; nodeId < graph->getNodeCount(); nodeId++) {
+            int i, j;
+            graph->getNodeCoords(nodeId, i, j);
+                
+            for (int d = 0; d < 4; d++) {
+                int ni = i + dr[d];
+                int nj = j + dc[d];
+
+                int neighborId = coordMap->get(ni, nj);
+                    
+                if (neighborId != -1) {
+                    graph->addEdge(nodeId, neighborId, maze->getCost(ni, nj));
+                }
+            }
+        }
+
+        graph->finalize();
+    }
+
+    void addNodesInOrder(int openCells) {
+
+        // PURPOSE: Create the graph nodes in nodeOrder (see NODE ORDERING)
+        int rows = maze->getRows();
+        int cols = maze->getCols();
+        int* cells = new int[openCells > 0 ? openCells : 1];    // r * cols + c, in id order
+        int count = 0;
+
+        if (nodeOrder == NODE_ORDER_BFS) {
+
+            // cells doubles as the BFS queue. Cells S cannot reach are numbered
+            // afterwards by further BFS runs seeded in row-major order.
+            int dr[] = {0, 0, 1, -1};
+            int dc[] = {1, -1, 0, 0};
+            int seedRow = maze->getStartRow(), seedCol = maze->getStartCol();
+            long long scan = 0;
+            int head = 0;
+            while (count < openCells) {
+
+                if (count > 0) {
+                    while (!maze->isOpen((int)(scan / cols), (int)(scan % cols)) ||
+                           coordMap->get((int)(scan / cols), (int)(scan % cols)) != -1) {
+                        scan++;
+                    }
+                    seedRow = (int)(scan / cols);
+                    seedCol = (int)(scan % cols);
+                }
+                coordMap->insert(seedRow, seedCol, count);
+                cells[count++] = seedRow * cols + seedCol;
+
+                while (head < count) {
+                    int r = cells[head] / cols;
+                    int c = cells[head] % cols;
+                    head++;
+                    for (int d = 0; d < 4; d++) {
+                        int nr = r + dr[d];
+                        int nc = c + dc[d];
+                        if (maze->isOpen(nr, nc) && coordMap->get(nr, nc) == -1) {
+                            coordMap->insert(nr, nc, count);
+                            cells[count++] = nr * cols + nc;
+                        }
+                    }
+                }
+            }
+
+        } else {
+
+            int bits = 0;
+            while ((1LL << bits) < rows || (1LL << bits) < cols) bits++;
+
+            unsigned long long* keys = new unsigned long long[openCells > 0 ? openCells : 1];
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    if (!maze->isOpen(i, j)) continue;
+                    keys[count] = nodeOrder == NODE_ORDER_MORTON ? mortonKey(i, j) : hilbertKey(i, j, bits);
+                    cells[count++] = i * cols + j;
+                }
+            }
+            radixSortByKey(keys, cells, count);
+            delete[] keys;
+
+            for (int k = 0; k < count; k++) coordMap->insert(cells[k] / cols, cells[k] % cols, k);
+
+        }
+
+        for (int k = 0; k < count; k++) graph->addNode(cells[k] / cols, cells[k] % cols);
+        delete[] cells;
+
+    }
+
+    void useGrid() {
+
+        // PURPOSE: Switch to implicit-grid mode (see IMPLICIT GRID GRAPH)
+        implicitGrid = true;
+        grid = new GridGraph(maze);
+        startNode = grid->nodeAt(maze->getStartRow(), maze->getStartCol());
+        endNode = grid->nodeAt(maze->getEndRow(), maze->getEndCol());
+
+    }
+
+    bool useStoredGraph() {
+
+        // PURPOSE: Search the graph loaded with a binary maze file instead of building one
+        // Its nodes are the open cells in row-major order, so a rank index over
+        // the walkability bits maps cells to nodes without a per-cell table
+        CSRGraph* stored = maze->getStoredGraph();
+        CoordIndex* index = new CoordIndex(maze->getRows(), maze->getCols(), maze->getOpenBits(),
+                                           maze->getRowWords());
+        if (index->getRankedCount() != stored->getNodeCount()) {
+            delete index;
+            return false;
+        }
+
+        graph = stored;
+        coordMap = index;
+        ownsGraph = false;
+        startNode = coordMap->get(maze->getStartRow(), maze->getStartCol());
+        endNode = coordMap->get(maze->getEndRow(), maze->getEndCol());
+        return true;
+
+    }
+
+    int getNodeSpace() {
+
+        // PURPOSE: Size of per-node arrays (ids range over [0, nodeSpace))
+        return implicitGrid ? grid->getNodeSpace() : graph->getNodeCount();
+
+    }
+
+    int getNeighbors(int node, int nbrs[]) {
+
+        // PURPOSE: Fill nbrs (MAX_DEGREE entries) with the neighbors of node
+        if (implicitGrid) return grid->getNeighbors(node, nbrs);
+
+        int count = 0;
+        int edgeEnd = graph->getEdgeEnd(node);
+        for (int e = graph->getEdgeBegin(node); e < edgeEnd; e++) {
+            nbrs[count++] = graph->getEdgeDest(e);
+        }
+        return count;
+
+    }
+
+    bool isNodeOpen(int node) {
+
+        // PURPOSE: False for wall ids, which only exist in implicit-grid mode
+        return implicitGrid ? grid->isOpen(node) : true;
+
+    }
+
+    int getWeightedNeighbors(int node, int nbrs[], int weights[]) {
+
+        // PURPOSE: Like getNeighbors, plus the cost of each edge
+        if (implicitGrid) {
+            int degree = grid->getNeighbors(node, nbrs);
+            for (int k = 0; k < degree; k++) weights[k] = grid->getCost(nbrs[k]);
+            return degree;
+        }
+
+        int count = 0;
+        int edgeEnd = graph->getEdgeEnd(node);
+        for (int e = graph->getEdgeBegin(node); e < edgeEnd; e++) {
+            nbrs[count] = graph->getEdgeDest(e);
+            weights[count++] = graph->getEdgeWeight(e);
+        }
+        return count;
+
+    }
+
+    void getNodeCoords(int node, int& row, int& col) {
+
+        if (implicitGrid) grid->getNodeCoords(node, row, col);
+        else graph->getNodeCoords(node, row, col);
+
+    }
+    
+    SearchWorkspace* getWorkspace() {
+
+        // PURPOSE: The solver's own workspace (built on first use)
+        if (workspace == NULL) workspace = new SearchWorkspace(getNodeSpace());
+        return workspace;
+
+    }
+
+    GridGraph* getGrid() {
+
+        // PURPOSE: Grid view for searches that need cell geometry (built on first use)
+        if (grid == NULL) grid = new GridGraph(maze);
+        return grid;
+
+    }
+
+    int jumpHorizontal(GridGraph* g, int node, int dx, int goal) {
+
+        // PURPOSE: Move along a row from node until a jump point, or -1 at a wall
+        // A cell is a jump point if it is the goal, or if a cell above or below
+        // it is open while the cell diagonally behind is a wall (a forced neighbor)
+        int stride = g->getStride();
+        int curr = node;
+        while (true) {
+            curr += dx;
+            if (!g->isOpen(curr)) return -1;
+            if (curr == goal) return curr;
+            if ((g->isOpen(curr - stride) && !g->isOpen(curr - dx - stride)) ||
+                (g->isOpen(curr + stride) && !g->isOpen(curr - dx + stride))) {
+                return curr;
+            }
+        }
+
+    }
+
+    int jumpVertical(GridGraph* g, int node, int dy, int goal) {
+
+        // PURPOSE: Move along a column from node until a jump point, or -1 at a wall
+        // Besides forced neighbors, a cell is a jump point when a horizontal
+        // scan from it reaches a jump point
+        int curr = node;
+        while (true) {
+            curr += dy;
+            if (!g->isOpen(curr)) return -1;
+            if (curr == goal) return curr;
+            if ((g->isOpen(curr - 1) && !g->isOpen(curr - 1 - dy)) ||
+                (g->isOpen(curr + 1) && !g->isOpen(curr + 1 - dy))) {
+                return curr;
+            }
+            if (jumpHorizontal(g, curr, 1, goal) != -1 || jumpHorizontal(g, curr, -1, goal) != -1) {
+                return curr;
+            }
+        }
+
+    }
+
+    long long aStarKey(int g, int node, int endRow, int endCol, const int* targetDists = NULL) {
+
+        // PURPOSE: Heap key for A*: f = g + h, ties broken toward smaller h
+        // h is Manhattan distance, raised to the landmark bound when the
+        // target's landmark distances are given
+        int r, c;
+        getNodeCoords(node, r, c);
+        int h = (r > endRow ? r - endRow : endRow - r) + (c > endCol ? c - endCol : endCol - c);
+        if (targetDists != NULL) {
+            int bound = landmarks->lowerBound(landmarks->getDistances(node), targetDists);
+            if (bound > h) h = bound;
+        }
+        return ((long long)(g + h) << 32) | (unsigned int)h;
+
+    }
+
+    long long jpsKey(GridGraph* g, int gCost, int node, int endRow, int endCol) {
+
+        int r, c;
+        g->getNodeCoords(node, r, c);
+        int h = (r > endRow ? r - endRow : endRow - r) + (c > endCol ? c - endCol : endCol - c);
+        return ((long long)(gCost + h) << 32) | (unsigned int)h;
+
+    }
+
+    int reconstructPath(int parent[], int path[], int target) {
+        int pathLen = 0;
+        int curr = target;
+        int cols = maze->getCols();
+
+        // Walk the parent chain once for the length; that is all a NULL path needs
+        while (curr != -1) {
+            pathLen++;
+            curr = parent[curr];
+        }
+        if (path == NULL) return pathLen;
+        
+        // Walk it again filling the path from the back, so no stack is allocated
+        curr = target;
+        for (int i = pathLen - 1; i >= 0; i--) {
+
+            int r, c;
+            getNodeCoords(curr, r, c);
+            path[i] = r * cols + c;
+            curr = parent[curr];
+
+        }
+        
+        return pathLen;
+    }
+    
+public:
+    // useImplicitGrid: search the grid directly instead of building a graph
+    // (mazes with more than INT_MAX edges always do; see isImplicitGrid)
+    // order: how the explicit graph numbers its nodes (see NODE ORDERING)
+    MazeSolver(Maze* m, bool useImplicitGrid = false, int order = NODE_ORDER_ROW_MAJOR) : maze(m), graph(NULL), coordMap(NULL),
+        grid(NULL), implicitGrid(useImplicitGrid), startNode(-1), endNode(-1),
+        threadCount(defaultThreadCount()), pool(NULL), workspace(NULL), dfs(NULL), ownsGraph(true),
+        nodeOrder(order), corridors(NULL), filledCorridors(NULL), bitBFS(NULL), landmarks(NULL), ownsLandmarks(false),
+        hierarchy(NULL), clusterSize(DEFAULT_CLUSTER_SIZE), builtAtEdit(m->getEditCount()) {
+
+        if (implicitGrid) {
+            useGrid();
+        } else if (nodeOrder != NODE_ORDER_ROW_MAJOR || maze->getStoredGraph() == NULL || !useStoredGraph()) {
+            // A stored graph is always numbered row-major
+            buildGraph();
+        }
+    }
+
+    int getMaxPathLength() {
+
+        // PURPOSE: Size of the path buffer callers must pass to the solvers
+        return implicitGrid ? grid->getOpenCount() : graph->getNodeCount();
+
+    }
+
+    bool isImplicitGrid() {
+
+        return implicitGrid;
+
+    }
+
+    void setThreadCount(int threads) {
+
+        threadCount = threads > 0 ? threads : 1;
+
+    }
+
+    int getThreadCount() {
+
+        return threadCount;
+
+    }
+
+    CSRGraph* getGraph() {
+
+        return graph;
+
+    }
+    
+    int cellToNode(int row, int col) {
+
+        // PURPOSE: Node id of an open cell, or -1 for walls and out-of-range cells
+        // USED IN: Batch queries, which name their endpoints by coordinates
+        if (row < 0 || row >= maze->getRows() || col < 0 || col >= maze->getCols()) return -1;
+        if (implicitGrid) {
+            int node = grid->nodeAt(row, col);
+            return grid->isOpen(node) ? node : -1;
+        }
+        return coordMap->get(row, col);
+
+    }
+    
+    bool isStale() {
+
+        // PURPOSE: True once a cell of the maze was edited after the solver was
+        // built. Its graph and lazily built structures (and the maze's labels
+        // and bits, which follow the edits) no longer agree, so every public
+        // search returns no path (see refuseStale).
+        return maze->getEditCount() != builtAtEdit;
+
+    }
+
+    bool refuseStale(int& pathLen, int& nodesVisited) {
+
+        // PURPOSE: First step of every public search: a stale solver reports
+        // no path instead of searching a graph that no longer matches the maze
+        if (!isStale()) return false;
+        pathLen = 0;
+        nodesVisited = 0;
+        return true;
+
+    }
+
+    bool canReach(int source, int target) {
+
+        // PURPOSE: False when source and target lie in different components,
+        // so the search can be skipped (see COMPONENT LABELS), or when the
+        // solver is stale
+        if (isStale()) return false;
+        int sourceRow, sourceCol, targetRow, targetCol;
+        getNodeCoords(source, sourceRow, sourceCol);
+        getNodeCoords(target, targetRow, targetCol);
+        return maze->getComponents()->connected(sourceRow, sourceCol, targetRow, targetCol);
+
+    }
+
+    bool isEndReachable() {
+
+        return canReach(startNode, endNode);
+
+    }
+
+    int bfsDistances(int source, int dist[], int queue[]) {
+
+        // PURPOSE: Steps from source to every node (-1 when unreachable); queue
+        // needs getMaxPathLength() entries and ends holding the reached nodes
+        // in BFS order. Returns how many were reached.
+        int nodeCount = getNodeSpace();
+        for (int i = 0; i < nodeCount; i++) dist[i] = -1;
+        int head = 0, tail = 0;
+        dist[source] = 0;
+        queue[tail++] = source;
+
+        while (head < tail) {
+
+            int curr = queue[head++];
+            int nbrs[MAX_DEGREE];
+            int degree = getNeighbors(curr, nbrs);
+            for (int k = 0; k < degree; k++) {
+                if (dist[nbrs[k]] < 0) {
+                    dist[nbrs[k]] = dist[curr] + 1;
+                    queue[tail++] = nbrs[k];
+                }
+            }
+        }
+
+        return tail;
+
+    }
+
+    // Pick count landmarks by farthest-point selection and store the BFS
+    // distances from each (see LANDMARKS). The first is the node farthest from
+    // S; each next one is the node farthest from its nearest landmark so far,
+    // which puts them at the far ends of the maze. They are picked in S's
+    // component, so queries elsewhere get the Manhattan bound only.
+    // The table stored with a binary maze is used instead when it has count
+    // landmarks and this solver's node numbering. Returns the landmark count,
+    // which is smaller than count when S's component has fewer cells.
+    int buildLandmarks(int count) {
+
+        if (ownsLandmarks) delete landmarks;
+        landmarks = NULL;
+        ownsLandmarks = false;
+        if (count < 1) count = 1;
+
+        LandmarkTable* stored = maze->getStoredLandmarks();
+        if (stored != NULL && stored->getCount() == count && !implicitGrid &&
+            nodeOrder == NODE_ORDER_ROW_MAJOR && stored->getNodeCount() == getNodeSpace()) {
+            landmarks = stored;
+            return count;
+        }
+
+        int nodeCount = getNodeSpace();
+        int* dist = new int[nodeCount];
+        int* nearest = new int[nodeCount];   // Steps to the closest landmark chosen so far
+        int* queue = new int[getMaxPathLength() + 1];
+
+        int reached = bfsDistances(startNode, dist, queue);
+        if (count > reached) count = reached;
+        int next = queue[reached - 1];
+        for (int v = 0; v < nodeCount; v++) nearest[v] = INT_MAX;
+
+        LandmarkTable* table = new LandmarkTable(count, nodeCount);
+        for (int i = 0; i < count; i++) {
+
+            table->setLandmark(i, next);
+            bfsDistances(next, dist, queue);
+            int farthest = next;
+            int farthestDist = -1;
+            for (int v = 0; v < nodeCount; v++) {
+                table->setDistance(v, i, dist[v]);
+                if (dist[v] < 0) continue;
+                if (dist[v] < nearest[v]) nearest[v] = dist[v];
+                if (nearest[v] > farthestDist) {
+                    farthestDist = nearest[v];
+                    farthest = v;
+                }
+            }
+            next = farthest;
+
+        }
+
+        delete[] dist;
+        delete[] nearest;
+        delete[] queue;
+        landmarks = table;
+        ownsLandmarks = true;
+        return count;
+
+    }
+
+    LandmarkTable* getLandmarks() {
+
+        // PURPOSE: Table set by buildLandmarks, or NULL
+        return landmarks;
+
+    }
+    
+    // BFS Algorithm using Queue
+
+    bool solveBFS(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        return queryBFS(startNode, endNode, path, pathLen, nodesVisited);
+
+    }
+
+    SearchWorkspace* createWorkspace() {
+
+        // PURPOSE: A separate workspace for a thread running queries
+        return new SearchWorkspace(getNodeSpace());
+
+    }
+
+    DFSSearch* createDFS() {
+
+        // PURPOSE: Frame stack for a resumable DFS (one per search in flight)
+        return new DFSSearch(getMaxPathLength());
+
+    }
+
+    // Start a DFS from source; nothing is expanded until resumeDFS.
+    // ws = NULL uses the solver's workspace, so give each search that is
+    // interleaved with other searches its own.
+    void beginDFS(DFSSearch* search, int source, int target, SearchWorkspace* ws = NULL) {
+
+        if (ws == NULL) ws = getWorkspace();
+        search->begin(ws, target);
+        search->enter(source, -1);
+
+    }
+
+    // Expand up to maxExpansions more nodes (all of them when negative) and
+    // return DFS_PAUSED, DFS_FOUND or DFS_EXHAUSTED. A paused search picks up
+    // at the same neighbor of the same frame the next time it is resumed.
+    // A stale solver expands nothing and reports DFS_EXHAUSTED.
+    int resumeDFS(DFSSearch* search, long long maxExpansions) {
+
+        if (isStale()) return DFS_EXHAUSTED;
+        SearchWorkspace* ws = search->getWorkspace();
+        long long expanded = 0;
+
+        while (search->getStatus() == DFS_PAUSED) {
+
+            if (maxExpansions >= 0 && expanded >= maxExpansions) break;
+
+            int curr = search->topNode();
+            int nbrs[MAX_DEGREE];
+            int degree = getNeighbors(curr, nbrs);
+
+            // Skip neighbors seen since this frame last looked, as the recursive loop did
+            int k = search->topNext();
+            while (k < degree && ws->isSeen(nbrs[k])) k++;
+
+            if (k == degree) {
+
+                search->pop();
+                continue;
+
+            }
+
+            search->setTopNext(k + 1);
+            search->enter(nbrs[k], curr);
+            expanded++;
+        }
+
+        return search->getStatus();
+
+    }
+
+    // Path of a search that returned DFS_FOUND; returns its length (0 once stale)
+    int getDFSPath(DFSSearch* search, int path[]) {
+
+        if (isStale()) return 0;
+        return reconstructPath(search->getWorkspace()->getParents(), path, search->getTarget());
+
+    }
+
+    // BFS between any two nodes. Only reads the solver, so several threads
+    // may run queries at once as long as each passes its own workspace
+    // (ws = NULL uses the solver's). path may be NULL when only the length is needed.
+    bool queryBFS(int source, int target, int path[], int& pathLen, int& nodesVisited,
+                  SearchWorkspace* ws = NULL) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        if (ws == NULL) ws = getWorkspace();
+        ws->reset();
+        int* parent = ws->getParents();
+        
+        QueueLinkedList q(ws->getListPool());
+        q.enqueue(source);
+        ws->markSeen(source);
+        parent[source] = -1;
+        nodesVisited = 0;
+        pathLen = 0;
+        bool found = false;
+        
+        while (!q.isEmpty()) {
+
+            int curr = q.dequeue();
+            nodesVisited++;
+            
+            if (curr == target) {
+
+                pathLen = reconstructPath(parent, path, target);
+                found = true;
+                break;
+
+            }
+            
+            int nbrs[MAX_DEGREE];
+            int degree = getNeighbors(curr, nbrs);
+            for (int k = 0; k < degree; k++) {
+                int neighbor = nbrs[k];
+                if (!ws->isSeen(neighbor)) {
+                    ws->markSeen(neighbor);
+                    parent[neighbor] = curr;
+                    q.enqueue(neighbor);
+                }
+            }
+        }
+        
+        return found;
+    }
+    
+    // DFS Algorithm using Stack
+    bool solveDFSStack(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        SearchWorkspace* ws = getWorkspace();
+        ws->reset();
+        int* parent = ws->getParents();
+
+        
+        StackLinkedList s(ws->getListPool());
+        s.push(startNode);
+        parent[startNode] = -1;
+        nodesVisited = 0;
+        pathLen = 0;
+        bool found = false;
+        
+
+
+        while (!s.isEmpty()) {
+
+            int curr = s.pop();
+            
+            if (ws->isSeen(curr)) continue;
+            ws->markSeen(curr);
+            nodesVisited++;
+            
+            if (curr == endNode) {
+
+
+                pathLen = reconstructPath(parent, path, endNode);
+                found = true;
+                break;
+            }
+            
+            int nbrs[MAX_DEGREE];
+            int degree = getNeighbors(curr, nbrs);
+            for (int k = 0; k < degree; k++) {
+                int neighbor = nbrs[k];
+                if (!ws->isSeen(neighbor)) {
+
+                    parent[neighbor] = curr;
+                    s.push(neighbor);
+
+                }
+
+            }
+        }
+        
+        return found;
+    }
+    
+    // DFS in the order of the recursive version, without recursion: the frames
+    // live in a DFSSearch, so deep mazes cannot overflow the thread stack
+    bool solveDFSRecursive(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        if (dfs == NULL) dfs = createDFS();
+        beginDFS(dfs, startNode, endNode);
+        resumeDFS(dfs, -1);
+
+        nodesVisited = dfs->getNodesVisited();
+        pathLen = 0;
+        bool found = dfs->getStatus() == DFS_FOUND;
+        if (found) {
+            pathLen = reconstructPath(dfs->getWorkspace()->getParents(), path, endNode);
+        }
+        
+        return found;
+    }
+    
+    // A* Algorithm using a 4-ary indexed heap
+    // Every step costs at least 1, so Manhattan distance never overestimates
+    // and the first time E is expanded its path is a cheapest path.
+    bool solveAStar(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        return queryAStar(startNode, endNode, path, pathLen, nodesVisited);
+
+    }
+
+    // A* with landmark lower bounds (ALT); builds DEFAULT_LANDMARK_COUNT
+    // landmarks on first use unless buildLandmarks already ran
+    bool solveLandmarkAStar(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        if (landmarks == NULL) buildLandmarks(DEFAULT_LANDMARK_COUNT);
+        return queryAStar(startNode, endNode, path, pathLen, nodesVisited, NULL, true);
+
+    }
+
+    // A* between any two nodes; thread-safe in the same way as queryBFS
+    // useLandmarks adds the landmark bound to the heuristic once buildLandmarks has run
+    bool queryAStar(int source, int target, int path[], int& pathLen, int& nodesVisited,
+                    SearchWorkspace* ws = NULL, bool useLandmarks = false) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        if (ws == NULL) ws = getWorkspace();
+        ws->reset();
+        int* gScore = ws->getDist();     // Valid only for seen nodes
+        int* parent = ws->getParents();
+
+        int endRow, endCol;
+        getNodeCoords(target, endRow, endCol);
+        const int* targetDists = useLandmarks && landmarks != NULL ? landmarks->getDistances(target) : NULL;
+
+        IndexedMinHeap* open = ws->getHeap();
+        ws->markSeen(source);
+        gScore[source] = 0;
+        parent[source] = -1;
+        open->push(source, aStarKey(0, source, endRow, endCol, targetDists));
+        nodesVisited = 0;
+        pathLen = 0;
+        bool found = false;
+
+        while (!open->isEmpty()) {
+
+            int curr = open->popMin();
+            ws->markDone(curr);
+            nodesVisited++;
+
+            if (curr == target) {
+
+                pathLen = reconstructPath(parent, path, target);
+                found = true;
+                break;
+
+            }
+
+            int nbrs[MAX_DEGREE];
+            int weights[MAX_DEGREE];
+            int degree = getWeightedNeighbors(curr, nbrs, weights);
+            for (int k = 0; k < degree; k++) {
+                int neighbor = nbrs[k];
+                if (ws->isDone(neighbor)) continue;
+
+                int g = gScore[curr] + weights[k];
+                if (!ws->isSeen(neighbor) || g < gScore[neighbor]) {
+                    ws->markSeen(neighbor);
+                    gScore[neighbor] = g;
+                    parent[neighbor] = curr;
+                    open->push(neighbor, aStarKey(g, neighbor, endRow, endCol, targetDists));
+                }
+            }
+        }
+
+        return found;
+    }
+
+    // Bidirectional BFS
+    // Expands whole levels from S and from E, always growing the smaller
+    // frontier. Once a level produces a node already reached from the other
+    // side, the best meeting node of that level lies on a shortest path.
+    // nodesVisited counts nodes expanded from both sides.
+    bool solveBidirectionalBFS(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        int nodeCount = getNodeSpace();
+        int* dist[2];
+        int* parent[2];
+        int* queue[2];
+        int head[2], tail[2];
+        for (int side = 0; side < 2; side++) {
+            dist[side] = new int[nodeCount];
+            parent[side] = new int[nodeCount];
+            queue[side] = new int[nodeCount];
+            for (int i = 0; i < nodeCount; i++) {
+                dist[side][i] = -1;
+                parent[side][i] = -1;
+            }
+            head[side] = tail[side] = 0;
+        }
+
+        dist[0][startNode] = 0;
+        queue[0][tail[0]++] = startNode;
+        dist[1][endNode] = 0;
+        queue[1][tail[1]++] = endNode;
+        nodesVisited = 0;
+        pathLen = 0;
+
+        int meet = (startNode == endNode) ? startNode : -1;
+        int best = (meet != -1) ? 0 : INT_MAX;
+
+        while (meet == -1 && head[0] < tail[0] && head[1] < tail[1]) {
+
+            int side = (tail[0] - head[0] <= tail[1] - head[1]) ? 0 : 1;
+            int other = 1 - side;
+            int levelEnd = tail[side];
+
+            while (head[side] < levelEnd) {
+                int curr = queue[side][head[side]++];
+                nodesVisited++;
+
+                int nbrs[MAX_DEGREE];
+                int degree = getNeighbors(curr, nbrs);
+                for (int k = 0; k < degree; k++) {
+                    int neighbor = nbrs[k];
+                    if (dist[side][neighbor] != -1) continue;
+
+                    dist[side][neighbor] = dist[side][curr] + 1;
+                    parent[side][neighbor] = curr;
+                    queue[side][tail[side]++] = neighbor;
+
+                    if (dist[other][neighbor] != -1) {
+                        int total = dist[side][neighbor] + dist[other][neighbor];
+                        if (total < best) {
+                            best = total;
+                            meet = neighbor;
+                        }
+                    }
+                }
+            }
+        }
+
+        bool found = (meet != -1);
+        if (found) {
+
+            // S .. meet from the forward parents, then meet .. E from the backward ones
+            int cols = maze->getCols();
+            int forwardLen = dist[0][meet] + 1;
+            int index = forwardLen - 1;
+            for (int node = meet; node != -1; node = parent[0][node]) {
+                int r, c;
+                getNodeCoords(node, r, c);
+                path[index--] = r * cols + c;
+            }
+            pathLen = forwardLen;
+            for (int node = parent[1][meet]; node != -1; node = parent[1][node]) {
+                int r, c;
+                getNodeCoords(node, r, c);
+                path[pathLen++] = r * cols + c;
+            }
+
+        }
+
+        for (int side = 0; side < 2; side++) {
+            delete[] dist[side];
+            delete[] parent[side];
+            delete[] queue[side];
+        }
+        return found;
+    }
+
+    // Direction-optimizing BFS
+    // Level-synchronous BFS that switches between top-down steps (scan the
+    // frontier's edges) and bottom-up steps (each unvisited node looks for a
+    // parent in the frontier), whichever touches fewer edges. It switches to
+    // bottom-up when the frontier's edges exceed 1/ALPHA of the unexplored
+    // edges, and back when the frontier drops below 1/BETA of the nodes.
+    // nodesVisited counts nodes reached.
+    bool solveDirectionOptimizingBFS(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        const int ALPHA = 14;
+        const int BETA = 24;
+
+        int nodeCount = getNodeSpace();
+        int* dist = new int[nodeCount];
+        int* parent = new int[nodeCount];
+        int* frontier = new int[nodeCount];
+        int* next = new int[nodeCount];
+
+        long long unexploredEdges = 0;
+        int openNodes = 0;
+        int nbrs[MAX_DEGREE];
+        int discovered[MAX_DEGREE];    // Neighbors of a newly reached node, for the edge count
+        for (int i = 0; i < nodeCount; i++) {
+            dist[i] = -1;
+            parent[i] = -1;
+            if (isNodeOpen(i)) {
+                openNodes++;
+                unexploredEdges += getNeighbors(i, nbrs);
+            }
+        }
+
+        int frontierSize = 0;
+        frontier[frontierSize++] = startNode;
+        dist[startNode] = 0;
+        unexploredEdges -= getNeighbors(startNode, nbrs);
+        nodesVisited = 1;
+        pathLen = 0;
+        bool bottomUp = false;
+        int level = 0;
+
+        while (frontierSize > 0 && dist[endNode] == -1) {
+
+            long long frontierEdges = 0;
+            for (int i = 0; i < frontierSize; i++) frontierEdges += getNeighbors(frontier[i], nbrs);
+
+            if (!bottomUp && frontierEdges > unexploredEdges / ALPHA) {
+                bottomUp = true;
+            } else if (bottomUp && frontierSize < openNodes / BETA) {
+                bottomUp = false;
+            }
+
+            int nextSize = 0;
+            if (bottomUp) {
+
+                for (int node = 0; node < nodeCount; node++) {
+                    if (dist[node] != -1 || !isNodeOpen(node)) continue;
+                    int degree = getNeighbors(node, nbrs);
+                    for (int k = 0; k < degree; k++) {
+                        if (dist[nbrs[k]] == level) {
+                            dist[node] = level + 1;
+                            parent[node] = nbrs[k];
+                            next[nextSize++] = node;
+                            unexploredEdges -= degree;
+                            break;
+                        }
+                    }
+                }
+
+            } else {
+
+                for (int i = 0; i < frontierSize; i++) {
+                    int curr = frontier[i];
+                    int degree = getNeighbors(curr, nbrs);
+                    for (int k = 0; k < degree; k++) {
+                        int neighbor = nbrs[k];
+                        if (dist[neighbor] != -1) continue;
+                        dist[neighbor] = level + 1;
+                        parent[neighbor] = curr;
+                        next[nextSize++] = neighbor;
+                        unexploredEdges -= getNeighbors(neighbor, discovered);
+                    }
+                }
+
+            }
+
+            nodesVisited += nextSize;
+            int* swap = frontier;
+            frontier = next;
+            next = swap;
+            frontierSize = nextSize;
+            level++;
+        }
+
+        bool found = (dist[endNode] != -1);
+        if (found) pathLen = reconstructPath(parent, path, endNode);
+
+        delete[] dist;
+        delete[] parent;
+        delete[] frontier;
+        delete[] next;
+        return found;
+    }
+
+    // Parallel BFS (level-synchronous)
+    // Each level's frontier is split into chunks that pool threads claim from
+    // a shared counter. A node is claimed by the first thread whose
+    // compare-and-swap moves its parent from UNVISITED to the expanding node;
+    // each thread appends its claims to its own next-frontier buffer, and the
+    // buffers are concatenated between levels. Small frontiers are expanded on
+    // the calling thread only. nodesVisited counts nodes reached.
+    bool solveParallelBFS(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        const int UNVISITED = -2;
+        const int CHUNK = 256;
+        const int PARALLEL_THRESHOLD = 4096;
+
+        if (pool == NULL || pool->getThreadCount() != threadCount) {
+            delete pool;
+            pool = new ThreadPool(threadCount);
+        }
+
+        int nodeCount = getNodeSpace();
+        atomic<int>* parent = new atomic<int>[nodeCount];
+        for (int i = 0; i < nodeCount; i++) parent[i].store(UNVISITED, memory_order_relaxed);
+
+        int* frontier = new int[nodeCount];
+        int* next = new int[nodeCount];
+        int frontierSize = 0;
+
+        int threads = pool->getThreadCount();
+        int** localNext = new int*[threads];
+        int* localSize = new int[threads];
+        int* localCapacity = new int[threads];
+        for (int t = 0; t < threads; t++) {
+            localCapacity[t] = 1024;
+            localNext[t] = new int[localCapacity[t]];
+        }
+
+        parent[startNode].store(-1, memory_order_relaxed);
+        frontier[frontierSize++] = startNode;
+        nodesVisited = 1;
+        pathLen = 0;
+        atomic<int> cursor(0);
+
+        function<void(int)> expand = [&](int t) {
+            localSize[t] = 0;
+            while (true) {
+                int begin = cursor.fetch_add(CHUNK);
+                if (begin >= frontierSize) break;
+                int end = begin + CHUNK < frontierSize ? begin + CHUNK : frontierSize;
+
+                for (int i = begin; i < end; i++) {
+                    int curr = frontier[i];
+                    int nbrs[MAX_DEGREE];
+                    int degree = getNeighbors(curr, nbrs);
+                    for (int k = 0; k < degree; k++) {
+                        int neighbor = nbrs[k];
+                        if (parent[neighbor].load(memory_order_relaxed) != UNVISITED) continue;
+                        int expected = UNVISITED;
+                        if (!parent[neighbor].compare_exchange_strong(expected, curr)) continue;
+
+                        if (localSize[t] == localCapacity[t]) {
+                            int* grown = new int[localCapacity[t] * 2];
+                            memcpy(grown, localNext[t], sizeof(int) * (size_t)localSize[t]);
+                            delete[] localNext[t];
+                            localNext[t] = grown;
+                            localCapacity[t] *= 2;
+                        }
+                        localNext[t][localSize[t]++] = neighbor;
+                    }
+                }
+            }
+        };
+
+        while (frontierSize > 0 && parent[endNode].load() == UNVISITED) {
+
+            cursor.store(0);
+            int active = 1;
+            if (frontierSize >= PARALLEL_THRESHOLD) {
+                pool->run(expand);
+                active = threads;
+            } else {
+                expand(0);
+            }
+
+            // Concatenate the per-thread buffers into the next frontier
+            int nextSize = 0;
+            for (int t = 0; t < active; t++) {
+                memcpy(next + nextSize, localNext[t], sizeof(int) * (size_t)localSize[t]);
+                nextSize += localSize[t];
+            }
+
+            nodesVisited += nextSize;
+            int* swap = frontier;
+            frontier = next;
+            next = swap;
+            frontierSize = nextSize;
+        }
+
+        bool found = (parent[endNode].load() != UNVISITED);
+        if (found) {
+
+            int cols = maze->getCols();
+            pathLen = 0;
+            for (int node = endNode; node != -1; node = parent[node].load()) pathLen++;
+            int index = pathLen - 1;
+            for (int node = endNode; node != -1; node = parent[node].load()) {
+                int r, c;
+                getNodeCoords(node, r, c);
+                path[index--] = r * cols + c;
+            }
+
+        }
+
+        for (int t = 0; t < threads; t++) delete[] localNext[t];
+        delete[] localNext;
+        delete[] localSize;
+        delete[] localCapacity;
+        delete[] parent;
+        delete[] frontier;
+        delete[] next;
+        return found;
+    }
+
+    // Dijkstra's Algorithm using Dial's bucket queue
+    // Runs in O(V + E + C * maxWeight) where C is the path cost, with no heap log factor
+    bool solveDijkstra(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        int nodeCount = getNodeSpace();
+        long long* dist = new long long[nodeCount];
+        int* parent = new int[nodeCount];
+        bool* settled = new bool[nodeCount]();
+        for (int i = 0; i < nodeCount; i++) {
+            dist[i] = LLONG_MAX;
+            parent[i] = -1;
+        }
+
+        BucketQueue queue(nodeCount, maze->getMaxCost());
+        dist[startNode] = 0;
+        queue.push(startNode, 0);
+        nodesVisited = 0;
+        pathLen = 0;
+        bool found = false;
+
+        while (!queue.isEmpty()) {
+
+            long long d;
+            int curr = queue.popMin(d);
+            settled[curr] = true;
+            nodesVisited++;
+
+            if (curr == endNode) {
+
+                pathLen = reconstructPath(parent, path, endNode);
+                found = true;
+                break;
+
+            }
+
+            int nbrs[MAX_DEGREE];
+            int weights[MAX_DEGREE];
+            int degree = getWeightedNeighbors(curr, nbrs, weights);
+            for (int k = 0; k < degree; k++) {
+                int neighbor = nbrs[k];
+                if (settled[neighbor]) continue;
+
+                long long newDist = d + weights[k];
+                if (newDist < dist[neighbor]) {
+                    dist[neighbor] = newDist;
+                    parent[neighbor] = curr;
+                    queue.push(neighbor, newDist);
+                }
+            }
+        }
+
+        delete[] dist;
+        delete[] parent;
+        delete[] settled;
+        return found;
+    }
+
+    // Jump Point Search (4-directional)
+    // A* over jump points only: straight corridor runs and symmetric paths are
+    // skipped by the jump scans, and each jump costs its straight-line length.
+    // Returns false without searching on weighted mazes (see algorithmLimitation).
+    bool solveJPS(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        nodesVisited = 0;
+        pathLen = 0;
+        if (maze->hasWeights()) return false;
+
+        GridGraph* g = getGrid();
+        int stride = g->getStride();
+        int nodeCount = g->getNodeSpace();
+        int start = g->nodeAt(maze->getStartRow(), maze->getStartCol());
+        int goal = g->nodeAt(maze->getEndRow(), maze->getEndCol());
+        int endRow = maze->getEndRow();
+        int endCol = maze->getEndCol();
+        int cols = maze->getCols();
+
+        int* gScore = new int[nodeCount];
+        int* parent = new int[nodeCount];
+        bool* closed = new bool[nodeCount]();
+        for (int i = 0; i < nodeCount; i++) {
+            gScore[i] = INT_MAX;
+            parent[i] = -1;
+        }
+
+        IndexedMinHeap open(nodeCount);
+        gScore[start] = 0;
+        open.push(start, jpsKey(g, 0, start, endRow, endCol));
+        nodesVisited = 0;
+        pathLen = 0;
+        bool found = false;
+
+        while (!open.isEmpty()) {
+
+            int curr = open.popMin();
+            closed[curr] = true;
+            nodesVisited++;
+
+            if (curr == goal) {
+                found = true;
+                break;
+            }
+
+            // Directions worth scanning, pruned by the direction we arrived from
+            int dirs[4];
+            int dirCount = 0;
+            if (parent[curr] == -1) {
+                dirs[dirCount++] = 1;
+                dirs[dirCount++] = -1;
+                dirs[dirCount++] = stride;
+                dirs[dirCount++] = -stride;
+            } else {
+                int diff = curr - parent[curr];
+                if (diff > -stride && diff < stride) {
+                    dirs[dirCount++] = diff > 0 ? 1 : -1;
+                    dirs[dirCount++] = stride;
+                    dirs[dirCount++] = -stride;
+                } else {
+                    dirs[dirCount++] = diff > 0 ? stride : -stride;
+                    dirs[dirCount++] = 1;
+                    dirs[dirCount++] = -1;
+                }
+            }
+
+            for (int k = 0; k < dirCount; k++) {
+                int dir = dirs[k];
+                int jumpPoint = (dir == 1 || dir == -1) ? jumpHorizontal(g, curr, dir, goal)
+                                                        : jumpVertical(g, curr, dir, goal);
+                if (jumpPoint == -1 || closed[jumpPoint]) continue;
+
+                int distance = jumpPoint - curr;
+                if (distance < 0) distance = -distance;
+                if (distance >= stride) distance /= stride;
+
+                int newG = gScore[curr] + distance;
+                if (newG < gScore[jumpPoint]) {
+                    gScore[jumpPoint] = newG;
+                    parent[jumpPoint] = curr;
+                    open.push(jumpPoint, jpsKey(g, newG, jumpPoint, endRow, endCol));
+                }
+            }
+        }
+
+        if (found) {
+
+            // Expand the jump points back into every cell of the path
+            pathLen = gScore[goal] + 1;
+            int index = pathLen - 1;
+            int curr = goal;
+            while (parent[curr] != -1) {
+                int prev = parent[curr];
+                int diff = curr - prev;
+                int step = (diff > -stride && diff < stride) ? (diff > 0 ? 1 : -1) : (diff > 0 ? stride : -stride);
+                for (int cell = curr; cell != prev; cell -= step) {
+                    int r, c;
+                    g->getNodeCoords(cell, r, c);
+                    path[index--] = r * cols + c;
+                }
+                curr = prev;
+            }
+            int r, c;
+            g->getNodeCoords(curr, r, c);
+            path[index] = r * cols + c;
+
+        }
+
+        delete[] gScore;
+        delete[] parent;
+        delete[] closed;
+        return found;
+    }
+
+    // BFS expanding whole levels with bit operations on the maze bitmap.
+    // Not thread-safe (the bitmaps are built once and reused).
+    bool solveBFSBitParallel(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        if (bitBFS == NULL) bitBFS = new BitParallelBFS(maze);
+        return bitBFS->solve(maze->getStartRow(), maze->getStartCol(), maze->getEndRow(), maze->getEndCol(),
+                             path, pathLen, nodesVisited);
+
+    }
+    
+    // Dijkstra over junctions and dead ends only, with corridors as weighted
+    // edges (see CORRIDOR CONTRACTION); fillDeadEnds prunes dead-end branches first
+    bool solveContracted(int path[], int& pathLen, int& nodesVisited, bool fillDeadEnds = false) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        CorridorGraph*& contracted = fillDeadEnds ? filledCorridors : corridors;
+        if (contracted == NULL) {
+            GridGraph* g = getGrid();
+            contracted = new CorridorGraph(g, g->nodeAt(maze->getStartRow(), maze->getStartCol()),
+                                           g->nodeAt(maze->getEndRow(), maze->getEndCol()), fillDeadEnds);
+        }
+        return contracted->solve(path, pathLen, nodesVisited);
+
+    }
+
+    CorridorGraph* getCorridorGraph(bool fillDeadEnds) {
+
+        // PURPOSE: The contracted graph of the last solveContracted call, or NULL
+        return fillDeadEnds ? filledCorridors : corridors;
+
+    }
+
+    void setClusterSize(int size) {
+
+        // PURPOSE: Cluster side length for the hierarchy (rebuilt on next use if it changes)
+        if (size < 2) size = 2;
+        if (size == clusterSize) return;
+        clusterSize = size;
+        delete hierarchy;
+        hierarchy = NULL;
+
+    }
+
+    HierarchicalGraph* getHierarchy() {
+
+        // PURPOSE: Entrance graph for HPA* (built on first use, see HIERARCHICAL PATHFINDING)
+        if (hierarchy == NULL) {
+            hierarchy = new HierarchicalGraph(getGrid(), maze->getRows(), maze->getCols(), clusterSize,
+                                              maze->getMaxCost() <= 1);
+        }
+        return hierarchy;
+
+    }
+
+    // HPA*: route over cluster entrances, then refine inside the clusters on it.
+    // Not thread-safe (the hierarchy keeps one set of search arrays).
+    bool solveHierarchical(int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        return queryHierarchical(startNode, endNode, path, pathLen, nodesVisited);
+
+    }
+
+    bool queryHierarchical(int source, int target, int path[], int& pathLen, int& nodesVisited) {
+
+        if (refuseStale(pathLen, nodesVisited)) return false;
+        HierarchicalGraph* h = getHierarchy();
+        int sourceRow, sourceCol, targetRow, targetCol;
+        getNodeCoords(source, sourceRow, sourceCol);
+        getNodeCoords(target, targetRow, targetCol);
+        return h->solve(grid->nodeAt(sourceRow, sourceCol), grid->nodeAt(targetRow, targetCol), path,
+                        getMaxPathLength(), pathLen, nodesVisited);
+
+    }
+    
+    ~MazeSolver() {
+        delete hierarchy;
+        delete corridors;
+        delete filledCorridors;
+        delete bitBFS;
+        if (ownsLandmarks) delete landmarks;
+        if (ownsGraph) delete graph;
+        delete coordMap;
+        delete grid;
+        delete pool;
+        delete workspace;
+        delete dfs;
+    }
+};
+
+// ==================== RANDOM NUMBERS ====================
+// PURPOSE: Small seedable generator so generated mazes are reproducible
+// xorshift64* (Vigna): 64 bits of state, one multiply per number
+// USED IN: Maze generators, benchmark corpus
+
+class Random {
+
+private:
+
+    unsigned long long state;
+
+public:
+
+    Random(unsigned long long seed) {
+        // Scramble the seed so nearby seeds give unrelated sequences; state must not be 0
+        state = seed * 0x9e3779b97f4a7c15ULL + 0x2545f4914f6cdd1dULL;
+        if (state == 0) state = 1;
+    }
+
+    unsigned long long next() {
+
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dULL;
+
+    }
+
+    int nextInt(int n) {
+
+        // PURPOSE: Uniform-enough integer in [0, n)
+        return (int)((next() >> 33) % (unsigned long long)n);
+
+    }
+
+    double nextDouble() {
+
+        // PURPOSE: Uniform double in [0, 1)
+        return (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+
+    }
+};
+
+// ==================== MAZE GENERATORS ====================
+// PURPOSE: Seedable generators that write mazes in the input text format
+// Perfect mazes (backtracker, Prim, Kruskal) are carved on a grid of cells
+// at odd text coordinates; the even positions between them are the walls.
+// Carving keeps one byte per cell (a quarter byte per text cell) and the
+// text is written one row at a time, so no generator holds the maze as text.
+// Rooms need only O(cols) memory.
+// USED IN: --generate, benchmark corpus
+
+class MazeOutput {
+
+    // PURPOSE: Destination of generated rows: a file, or a buffer of
+    // rows * (cols + 1) chars that Maze::loadFromText can read
+
+private:
+
+    ofstream* file;
+    char* buffer;
+    long long used;
+
+public:
+
+    MazeOutput(ofstream* f) : file(f), buffer(NULL), used(0) {}
+
+    MazeOutput(char* buf) : file(NULL), buffer(buf), used(0) {}
+
+    void writeRow(const char* row, int len) {
+
+        if (file != NULL) {
+            file->write(row, len);
+            file->put('\n');
+        } else {
+            memcpy(buffer + used, row, (size_t)len);
+            used += len;
+            buffer[used++] = '\n';
+        }
+
+    }
+
+    long long getLength() {
+
+        return used;
+
+    }
+};
+
+class RandomPermutation {
+
+    // PURPOSE: Visit 0 .. n-1 in shuffled order without storing the order
+    // A 4-round Feistel network is a bijection on [0, 4^k); map(i) for
+    // i < getDomain() covers every value once, and callers skip values >= n.
+    // The domain is less than 4n, so at most 3 of every 4 values are skipped.
+
+private:
+
+    int halfBits;
+    unsigned long long halfMask;
+    unsigned long long keys[4];
+    long long domain;
+
+    unsigned long long round(unsigned long long x, unsigned long long key) {
+
+        x = (x ^ key) * 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 31;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 29;
+        return x & halfMask;
+
+    }
+
+public:
+
+    RandomPermutation(long long n, Random& rng) {
+        halfBits = 1;
+        while ((1LL << (2 * halfBits)) < n) halfBits++;
+        halfMask = (1ULL << halfBits) - 1;
+        domain = 1LL << (2 * halfBits);
+        for (int k = 0; k < 4; k++) keys[k] = rng.next();
+    }
+
+    long long getDomain() {
+
+        return domain;
+
+    }
+
+    long long map(long long i) {
+
+        unsigned long long left = ((unsigned long long)i >> halfBits) & halfMask;
+        unsigned long long right = (unsigned long long)i & halfMask;
+        for (int k = 0; k < 4; k++) {
+            unsigned long long next = left ^ round(right, keys[k]);
+            left = right;
+            right = next;
+        }
+        return (long long)((left << halfBits) | right);
+
+    }
+};
+
+class PerfectMazeGrid {
+
+    // PURPOSE: Cell grid that the perfect-maze generators carve passages in
+    // Each cell byte records whether the walls to its right and below are
+    // open, plus scratch bits for the carving algorithms. Directions are
+    // 0 right, 1 left, 2 down, 3 up, so d ^ 1 is the opposite of d.
+
+private:
+
+    int cellRows, cellCols;
+    unsigned char* cells;
+
+public:
+
+    static const unsigned char OPEN_RIGHT = 1;
+    static const unsigned char OPEN_DOWN = 2;
+    static const unsigned char VISITED = 4;
+    static const unsigned char QUEUED = 8;     // In Prim's frontier
+    static const int BACK_SHIFT = 4;           // Bits 4-5: direction back to the parent
+
+    PerfectMazeGrid(int textRows, int textCols) {
+        cellRows = (textRows - 1) / 2;
+        cellCols = (textCols - 1) / 2;
+        cells = new unsigned char[(long long)cellRows * cellCols]();
+    }
+
+    int getCellCount() {
+
+        return cellRows * cellCols;
+
+    }
+
+    int getCellCols() {
+
+        return cellCols;
+
+    }
+
+    int getCellRows() {
+
+        return cellRows;
+
+    }
+
+    unsigned char& at(int cell) {
+
+        return cells[cell];
+
+    }
+
+    int neighbor(int cell, int d) {
+
+        // PURPOSE: Cell next to cell in direction d, or -1 outside the grid
+        int col = cell % cellCols;
+        switch (d) {
+            case 0: return col + 1 < cellCols ? cell + 1 : -1;
+            case 1: return col > 0 ? cell - 1 : -1;
+            case 2: return cell + cellCols < cellRows * cellCols ? cell + cellCols : -1;
+            default: return cell >= cellCols ? cell - cellCols : -1;
+        }
+
+    }
+
+    bool isPassage(int cell, int d) {
+
+        switch (d) {
+            case 0: return (cells[cell] & OPEN_RIGHT) != 0;
+            case 1: return cell % cellCols > 0 && (cells[cell - 1] & OPEN_RIGHT) != 0;
+            case 2: return (cells[cell] & OPEN_DOWN) != 0;
+            default: return cell >= cellCols && (cells[cell - cellCols] & OPEN_DOWN) != 0;
+        }
+
+    }
+
+    void prefetch(int cell) {
+
+        // PURPOSE: Hint that cell is about to be written
+#if defined(__GNUC__)
+        __builtin_prefetch(&cells[cell], 1);
+#else
+        (void)cell;
+#endif
+
+    }
+
+    void openPassage(int cell, int d) {
+
+        // PURPOSE: Remove the wall between cell and its neighbor in direction d
+        switch (d) {
+            case 0: cells[cell] |= OPEN_RIGHT; break;
+            case 1: cells[cell - 1] |= OPEN_RIGHT; break;
+            case 2: cells[cell] |= OPEN_DOWN; break;
+            default: cells[cell - cellCols] |= OPEN_DOWN; break;
+        }
+
+    }
+
+    void writeText(MazeOutput& out, int textRows, int textCols) {
+
+        // PURPOSE: Emit the maze row by row; S is the top-left cell and E the
+        // bottom-right one. Text rows or columns past the cell grid stay wall.
+        char* line = new char[textCols];
+        for (int r = 0; r < textRows; r++) {
+
+            memset(line, '#', (size_t)textCols);
+            if (r % 2 == 1 && (r - 1) / 2 < cellRows) {
+                int base = ((r - 1) / 2) * cellCols;
+                for (int j = 0; j < cellCols; j++) {
+                    line[2 * j + 1] = ' ';
+                    if (cells[base + j] & OPEN_RIGHT) line[2 * j + 2] = ' ';
+                }
+            } else if (r % 2 == 0 && r > 0 && r / 2 < cellRows) {
+                int base = (r / 2 - 1) * cellCols;
+                for (int j = 0; j < cellCols; j++) {
+                    if (cells[base + j] & OPEN_DOWN) line[2 * j + 1] = ' ';
+                }
+            }
+            if (r == 1) line[1] = 'S';
+            if (r == 2 * cellRows - 1) line[2 * cellCols - 1] = 'E';
+            out.writeRow(line, textCols);
+
+        }
+        delete[] line;
+
+    }
+
+    ~PerfectMazeGrid() {
+
+        delete[] cells;
+
+    }
+};
+
+void carveBacktracker(PerfectMazeGrid& grid, Random& rng) {
+
+    // PURPOSE: Recursive backtracker (randomized depth-first search)
+    // Long winding corridors and few branches. The way back is stored in each
+    // cell's back-direction bits instead of an explicit stack, so deep
+    // recursion costs no memory beyond the grid itself.
+    int start = 0;
+    int curr = start;
+    grid.at(curr) |= PerfectMazeGrid::VISITED;
+    while (true) {
+
+        int options[4];
+        int optionCount = 0;
+        for (int d = 0; d < 4; d++) {
+            int next = grid.neighbor(curr, d);
+            if (next != -1 && !(grid.at(next) & PerfectMazeGrid::VISITED)) options[optionCount++] = d;
+        }
+
+        if (optionCount > 0) {
+            int d = options[optionCount == 1 ? 0 : rng.nextInt(optionCount)];
+            int next = grid.neighbor(curr, d);
+            grid.openPassage(curr, d);
+            grid.at(next) |= (unsigned char)(PerfectMazeGrid::VISITED | ((d ^ 1) << PerfectMazeGrid::BACK_SHIFT));
+            curr = next;
+        } else {
+            if (curr == start) break;
+            curr = grid.neighbor(curr, (grid.at(curr) >> PerfectMazeGrid::BACK_SHIFT) & 3);
+        }
+
+    }
+
+}
+
+void carvePrim(PerfectMazeGrid& grid, Random& rng) {
+
+    // PURPOSE: Randomized Prim's algorithm
+    // Grows the maze from one cell by attaching a random frontier cell each
+    // step, which gives many short dead ends. The frontier is an array with
+    // swap-remove, so picking a random cell is O(1).
+    int cellCount = grid.getCellCount();
+    int* frontier = new int[cellCount];
+    int frontierSize = 0;
+
+    int start = rng.nextInt(cellCount);
+    grid.at(start) |= PerfectMazeGrid::VISITED;
+    for (int d = 0; d < 4; d++) {
+        int next = grid.neighbor(start, d);
+        if (next != -1) {
+            grid.at(next) |= PerfectMazeGrid::QUEUED;
+            frontier[frontierSize++] = next;
+        }
+    }
+
+    while (frontierSize > 0) {
+
+        int k = rng.nextInt(frontierSize);
+        int cell = frontier[k];
+        frontier[k] = frontier[--frontierSize];
+
+        // Attach to a random neighbor that is already part of the maze
+        int options[4];
+        int optionCount = 0;
+        for (int d = 0; d < 4; d++) {
+            int next = grid.neighbor(cell, d);
+            if (next != -1 && (grid.at(next) & PerfectMazeGrid::VISITED)) options[optionCount++] = d;
+        }
+        grid.openPassage(cell, options[optionCount == 1 ? 0 : rng.nextInt(optionCount)]);
+        grid.at(cell) |= PerfectMazeGrid::VISITED;
+
+        for (int d = 0; d < 4; d++) {
+            int next = grid.neighbor(cell, d);
+            if (next != -1 && !(grid.at(next) & (PerfectMazeGrid::VISITED | PerfectMazeGrid::QUEUED))) {
+                grid.at(next) |= PerfectMazeGrid::QUEUED;
+                frontier[frontierSize++] = next;
+            }
+        }
+
+    }
+
+    delete[] frontier;
+
+}
+
+void carveKruskal(PerfectMazeGrid& grid, Random& rng) {
+
+    // PURPOSE: Randomized Kruskal's algorithm
+    // Takes the walls in random order and removes each one that separates two
+    // cells not yet connected, tracked with a DisjointSet. Walls are numbered
+    // (horizontal ones first) and shuffled by RandomPermutation, so no wall
+    // list is stored.
+    int cellRows = grid.getCellRows();
+    int cellCols = grid.getCellCols();
+    long long horizontal = (long long)cellRows * (cellCols - 1);
+    long long wallCount = horizontal + (long long)(cellRows - 1) * cellCols;
+
+    DisjointSet sets(grid.getCellCount());
+    RandomPermutation order(wallCount, rng);
+    long long domain = order.getDomain();
+
+    // Random order means nearly every find() misses cache, so walls are
+    // decoded LOOKAHEAD steps early and their cells prefetched meanwhile
+    const int LOOKAHEAD = 32;
+    int pendingCell[LOOKAHEAD];
+    int pendingDir[LOOKAHEAD];
+    int pendingHead = 0, pendingCount = 0;
+    long long i = 0;
+    while (sets.getSetCount() > 1) {
+
+        while (pendingCount < LOOKAHEAD && i < domain) {
+            long long wall = order.map(i++);
+            if (wall >= wallCount) continue;
+
+            int cell, d;
+            if (wall < horizontal) {
+                cell = (int)(wall / (cellCols - 1)) * cellCols + (int)(wall % (cellCols - 1));
+                d = 0;
+            } else {
+                cell = (int)(wall - horizontal);
+                d = 2;
+            }
+            sets.prefetch(cell);
+            sets.prefetch(grid.neighbor(cell, d));
+            grid.prefetch(cell);
+            int slot = (pendingHead + pendingCount) % LOOKAHEAD;
+            pendingCell[slot] = cell;
+            pendingDir[slot] = d;
+            pendingCount++;
+        }
+        if (pendingCount == 0) break;
+
+        int cell = pendingCell[pendingHead];
+        int d = pendingDir[pendingHead];
+        pendingHead = (pendingHead + 1) % LOOKAHEAD;
+        pendingCount--;
+        if (sets.unite(cell, grid.neighbor(cell, d))) grid.openPassage(cell, d);
+
+    }
+
+}
+
+void braidMaze(PerfectMazeGrid& grid, Random& rng, double chance) {
+
+    // PURPOSE: Turn a perfect maze into a braided (loopy) one by opening one
+    // extra wall at each dead end with the given probability
+    int cellCount = grid.getCellCount();
+    for (int cell = 0; cell < cellCount; cell++) {
+
+        int openings = 0;
+        int closed[4];
+        int closedCount = 0;
+        for (int d = 0; d < 4; d++) {
+            if (grid.isPassage(cell, d)) openings++;
+            else if (grid.neighbor(cell, d) != -1) closed[closedCount++] = d;
+        }
+        if (openings == 1 && closedCount > 0 && rng.nextDouble() < chance) {
+            grid.openPassage(cell, closed[closedCount == 1 ? 0 : rng.nextInt(closedCount)]);
+        }
+
+    }
+
+}
+
+int chooseRoomWalls(int cols, Random& rng, int minRoom, int maxRoom, int wallCols[], bool isWall[]) {
+
+    // PURPOSE: Column walls of one band of rooms: both borders plus random
+    // inner walls leaving rooms minRoom .. maxRoom wide (the last may be wider)
+    memset(isWall, 0, (size_t)cols);
+    int count = 0;
+    wallCols[count++] = 0;
+    int x = 0;
+    while (true) {
+        int next = x + 1 + minRoom + rng.nextInt(maxRoom - minRoom + 1);
+        if (cols - 1 - next <= minRoom) break;
+        wallCols[count++] = next;
+        x = next;
+    }
+    wallCols[count++] = cols - 1;
+    for (int k = 0; k < count; k++) isWall[wallCols[k]] = true;
+    return count;
+
+}
+
+void generateRooms(int rows, int cols, Random& rng, MazeOutput& out) {
+
+    // PURPOSE: Open rectangular rooms in horizontal bands; each band has its
+    // own column walls. Rooms in a band are chained by a door in every wall
+    // between them, and every room has a door up into the band above, so
+    // all rooms connect. Bands are chosen as rows are written, so memory is O(cols).
+    const int MIN_ROOM = 4;
+    const int MAX_ROOM = 12;
+
+    int* wallCols = new int[cols];
+    int* nextWallCols = new int[cols];
+    bool* isWall = new bool[cols];
+    bool* nextIsWall = new bool[cols];
+    char* line = new char[cols];
+
+    int wallCount = chooseRoomWalls(cols, rng, MIN_ROOM, MAX_ROOM, wallCols, isWall);
+    int* doorRows = new int[cols];
+
+    memset(line, '#', (size_t)cols);
+    out.writeRow(line, cols);
+
+    int top = 0;
+    while (top < rows - 1) {
+
+        int bottom = top + 1 + MIN_ROOM + rng.nextInt(MAX_ROOM - MIN_ROOM + 1);
+        if (rows - 1 - bottom <= MIN_ROOM) bottom = rows - 1;
+
+        // One door per inner column wall in this band
+        for (int k = 1; k < wallCount - 1; k++) {
+            doorRows[k] = top + 1 + rng.nextInt(bottom - top - 1);
+        }
+
+        for (int r = top + 1; r < bottom; r++) {
+            memset(line, ' ', (size_t)cols);
+            for (int k = 0; k < wallCount; k++) {
+                bool door = (k > 0 && k < wallCount - 1 && doorRows[k] == r);
+                if (!door) line[wallCols[k]] = '#';
+            }
+            if (r == 1) line[1] = 'S';
+            if (r == rows - 2) line[cols - 2] = 'E';
+            out.writeRow(line, cols);
+        }
+
+        memset(line, '#', (size_t)cols);
+        if (bottom == rows - 1) {
+            out.writeRow(line, cols);
+            break;
+        }
+
+        // Wall row between this band and the next: one door into each room
+        // of the next band, placed where the cell above is not a wall
+        int nextCount = chooseRoomWalls(cols, rng, MIN_ROOM, MAX_ROOM, nextWallCols, nextIsWall);
+        for (int k = 0; k + 1 < nextCount; k++) {
+            int left = nextWallCols[k] + 1;
+            int width = nextWallCols[k + 1] - left;
+            int door = left + rng.nextInt(width);
+            for (int tries = 0; isWall[door] && tries < width; tries++) {
+                door = (door + 1 < left + width) ? door + 1 : left;
+            }
+            line[door] = ' ';
+        }
+        out.writeRow(line, cols);
+
+        int* swapCols = wallCols;
+        wallCols = nextWallCols;
+        nextWallCols = swapCols;
+        bool* swapWall = isWall;
+        isWall = nextIsWall;
+        nextIsWall = swapWall;
+        wallCount = nextCount;
+        top = bottom;
+
+    }
+
+    delete[] line;
+    delete[] doorRows;
+    delete[] wallCols;
+    delete[] nextWallCols;
+    delete[] isWall;
+    delete[] nextIsWall;
+
+}
+
+const int GENERATOR_COUNT = 5;
+const char* GENERATOR_NAMES[GENERATOR_COUNT] = {"backtracker", "prim", "kruskal", "braided", "rooms"};
+
+bool generateMaze(const char* algorithm, int rows, int cols, unsigned long long seed,
+                  double braidChance, MazeOutput& out) {
+
+    // PURPOSE: Write a rows x cols maze made by the named generator to out
+    // braidChance < 0 picks the default: 0.5 for "braided", 0 otherwise
+    int generator = -1;
+    for (int i = 0; i < GENERATOR_COUNT; i++) {
+        if (strcmp(algorithm, GENERATOR_NAMES[i]) == 0) generator = i;
+    }
+    if (generator == -1) {
+        cout << "Error: Unknown generator '" << algorithm << "' (use";
+        for (int i = 0; i < GENERATOR_COUNT; i++) cout << " " << GENERATOR_NAMES[i];
+        cout << ")" << endl;
+        return false;
+    }
+    if (rows < 5 || cols < 5) {
+        cout << "Error: Generated mazes need at least 5 rows and 5 columns" << endl;
+        return false;
+    }
+    if (!mazeSizeSupported(rows, cols)) {
+        cout << "Error: With a wall border around the maze, at most " << INT_MAX << " cells are supported" << endl;
+        return false;
+    }
+
+    Random rng(seed);
+    if (generator == 4) {
+        generateRooms(rows, cols, rng, out);
+        return true;
+    }
+
+    if (braidChance < 0) braidChance = (generator == 3) ? 0.5 : 0.0;
+
+    PerfectMazeGrid grid(rows, cols);
+    if (generator == 0 || generator == 3) carveBacktracker(grid, rng);
+    else if (generator == 1) carvePrim(grid, rng);
+    else carveKruskal(grid, rng);
+    if (braidChance > 0) braidMaze(grid, rng, braidChance);
+
+    grid.writeText(out, rows, cols);
+    return true;
+
+}
+
+// ==================== MEMORY USAGE ====================
+// PURPOSE: Report the peak resident memory of the process
+
+long long getPeakMemoryKB() {
+
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (long long)(counters.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return (long long)usage.ru_maxrss / 1024;   // Reported in bytes on macOS
+#else
+    return (long long)usage.ru_maxrss;          // Reported in kilobytes on Linux
+#endif
+#endif
+
+}
+
+// ==================== HARDWARE COUNTERS ====================
+// PURPOSE: Count cache misses around a piece of code
+// Uses Linux perf events for the calling thread in user mode: last-level
+// cache misses and L1 data cache read misses. Elsewhere, or when the kernel
+// does not allow perf events, isAvailable() is false and counts read -1.
+// USED IN: benchmarkNodeOrders
+
+class CacheMissCounter {
+
+private:
+
+    int lastLevelFd;
+    int l1Fd;
+
+#ifdef __linux__
+    static int openEvent(unsigned int type, unsigned long long config) {
+
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+    }
+#endif
+
+    long long readCount(int fd) {
+
+        long long count = -1;
+#ifdef __linux__
+        if (fd >= 0 && read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) count = -1;
+#else
+        (void)fd;
+#endif
+        return count;
+
+    }
+
+    void control(int fd, int request) {
+
+#ifdef __linux__
+        if (fd >= 0) ioctl(fd, (unsigned long)request, 0);
+#else
+        (void)fd;
+        (void)request;
+#endif
+
+    }
+
+public:
+
+    CacheMissCounter() : lastLevelFd(-1), l1Fd(-1) {
+#ifdef __linux__
+        lastLevelFd = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        l1Fd = openEvent(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+    }
+
+    bool isAvailable() {
+
+        return lastLevelFd >= 0 || l1Fd >= 0;
+
+    }
+
+    void start() {
+
+#ifdef __linux__
+        control(lastLevelFd, PERF_EVENT_IOC_RESET);
+        control(l1Fd, PERF_EVENT_IOC_RESET);
+        control(lastLevelFd, PERF_EVENT_IOC_ENABLE);
+        control(l1Fd, PERF_EVENT_IOC_ENABLE);
+#endif
+
+    }
+
+    void stop() {
+
+#ifdef __linux__
+        control(lastLevelFd, PERF_EVENT_IOC_DISABLE);
+        control(l1Fd, PERF_EVENT_IOC_DISABLE);
+#endif
+
+    }
+
+    long long getLastLevelMisses() {
+
+        return readCount(lastLevelFd);
+
+    }
+
+    long long getL1Misses() {
+
+        return readCount(l1Fd);
+
+    }
+
+    ~CacheMissCounter() {
+
+#ifdef __linux__
+        if (lastLevelFd >= 0) close(lastLevelFd);
+        if (l1Fd >= 0) close(l1Fd);
+#endif
+
+    }
+};
+
+// ==================== BENCHMARKS ====================
+// PURPOSE: Non-interactive measurements selected from the command line
+
+void benchmarkGraphBackends(Maze* maze, int rounds) {
+
+    // PURPOSE: Compare neighbor-iteration throughput of the linked-list Graph
+    // against CSRGraph by running full BFS traversals over both
+
+    int rows = maze->getRows();
+    int cols = maze->getCols();
+
+    // Dense cell -> node index shared by both builds
+    int* nodeOf = new int[(long long)rows * cols];
+    int nodeCount = 0;
+    long long edgeTotal = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            bool open = maze->isOpen(i, j);
+            nodeOf[(long long)i * cols + j] = open ? nodeCount++ : -1;
+        }
+    }
+
+    int dr[] = {0, 0, 1, -1};
+    int dc[] = {1, -1, 0, 0};
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (nodeOf[(long long)i * cols + j] == -1) continue;
+            for (int d = 0; d < 4; d++) {
+                int ni = i + dr[d], nj = j + dc[d];
+                if (ni >= 0 && ni < rows && nj >= 0 && nj < cols && nodeOf[(long long)ni * cols + nj] != -1) {
+                    edgeTotal++;
+                }
+            }
+        }
+    }
+
+    cout << "\n=====================================" << endl;
+    cout << "   GRAPH BACKEND BENCHMARK" << endl;
+    cout << "=====================================" << endl;
+    cout << "Nodes: " << nodeCount << ", directed edges: " << edgeTotal << ", rounds: " << rounds << endl;
+
+    if (nodeCount == 0 || edgeTotal > INT_MAX) {
+        cout << "Nothing to benchmark" << endl;
+        delete[] nodeOf;
+        return;
+    }
+
+    // Build both graphs with identical edge order
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    Graph* listGraph = new Graph(nodeCount);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (nodeOf[(long long)i * cols + j] != -1) listGraph->addNode(i, j);
+        }
+    }
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int u = nodeOf[(long long)i * cols + j];
+            if (u == -1) continue;
+            for (int d = 3; d >= 0; d--) {    // addEdge prepends, so add in reverse
+                int ni = i + dr[d], nj = j + dc[d];
+                if (ni >= 0 && ni < rows && nj >= 0 && nj < cols && nodeOf[(long long)ni * cols + nj] != -1) {
+                    listGraph->addEdge(u, nodeOf[(long long)ni * cols + nj], 1);
+                }
+            }
+        }
+    }
+    double listBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    CSRGraph* csrGraph = new CSRGraph(nodeCount, (int)edgeTotal);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (nodeOf[(long long)i * cols + j] != -1) csrGraph->addNode(i, j);
+        }
+    }
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int u = nodeOf[(long long)i * cols + j];
+            if (u == -1) continue;
+            for (int d = 0; d < 4; d++) {
+                int ni = i + dr[d], nj = j + dc[d];
+                if (ni >= 0 && ni < rows && nj >= 0 && nj < cols && nodeOf[(long long)ni * cols + nj] != -1) {
+                    csrGraph->addEdge(u, nodeOf[(long long)ni * cols + nj], 1);
+                }
+            }
+        }
+    }
+    csrGraph->finalize();
+    double csrBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    delete[] nodeOf;
+
+    // Full BFS traversals from node 0; both must scan the same edges
+    bool* visited = new bool[nodeCount];
+    int* queue = new int[nodeCount];
+    long long listEdges = 0, csrEdges = 0;
+    long long listChecksum = 0, csrChecksum = 0;
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        memset(visited, 0, (size_t)nodeCount);
+        int head = 0, tail = 0;
+        queue[tail++] = 0;
+        visited[0] = true;
+        while (head < tail) {
+            int curr = queue[head++];
+            for (AdjListNode* adj = listGraph->getAdjList(curr); adj != NULL; adj = adj->next) {
+                listEdges++;
+                if (!visited[adj->dest]) {
+                    visited[adj->dest] = true;
+                    queue[tail++] = adj->dest;
+                    listChecksum += adj->dest;
+                }
+            }
+        }
+    }
+    double listMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        memset(visited, 0, (size_t)nodeCount);
+        int head = 0, tail = 0;
+        queue[tail++] = 0;
+        visited[0] = true;
+        while (head < tail) {
+            int curr = queue[head++];
+            int edgeEnd = csrGraph->getEdgeEnd(curr);
+            for (int e = csrGraph->getEdgeBegin(curr); e < edgeEnd; e++) {
+                int neighbor = csrGraph->getEdgeDest(e);
+                csrEdges++;
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    queue[tail++] = neighbor;
+                    csrChecksum += neighbor;
+                }
+            }
+        }
+    }
+    double csrMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    cout << fixed << setprecision(3);
+    cout << "\nLinked list (AdjListNode):" << endl;
+    cout << "  Build time: " << listBuildMs << " ms" << endl;
+    cout << "  Traversal time: " << listMs << " ms" << endl;
+    cout << "  Throughput: " << (listMs > 0 ? (double)listEdges / listMs / 1000.0 : 0) << " M edges/s" << endl;
+    cout << "\nCSR:" << endl;
+    cout << "  Build time: " << csrBuildMs << " ms" << endl;
+    cout << "  Traversal time: " << csrMs << " ms" << endl;
+    cout << "  Throughput: " << (csrMs > 0 ? (double)csrEdges / csrMs / 1000.0 : 0) << " M edges/s" << endl;
+    if (csrMs > 0) {
+        cout << "\nCSR speedup: " << listMs / csrMs << "x" << endl;
+    }
+    if (listChecksum != csrChecksum || listEdges != csrEdges) {
+        cout << "Warning: backends disagree on the traversal" << endl;
+    }
+    cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "=====================================" << endl;
+
+    delete[] visited;
+    delete[] queue;
+    delete listGraph;
+    delete csrGraph;
+
+}
+
+void benchmarkCoordMaps(Maze* maze, int rounds) {
+
+    // PURPOSE: Compare lookup throughput of the chained HashMap, OpenHashMap
+    // and CoordIndex, in row-major order (as buildGraph probes) and in random order
+
+    int rows = maze->getRows();
+    int cols = maze->getCols();
+    long long cellCount = (long long)rows * cols;
+
+    int openCells = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (maze->isOpen(i, j)) openCells++;
+        }
+    }
+
+    cout << "\n=====================================" << endl;
+    cout << "   COORDINATE MAP BENCHMARK" << endl;
+    cout << "=====================================" << endl;
+    cout << "Cells: " << cellCount << ", open: " << openCells << ", rounds: " << rounds << endl;
+
+    if (openCells == 0) {
+        cout << "Nothing to benchmark" << endl;
+        return;
+    }
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    HashMap* chained = new HashMap(openCells);
+    int id = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (maze->isOpen(i, j)) chained->insert(i, j, id++);
+        }
+    }
+    double chainedBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    OpenHashMap* open = new OpenHashMap(openCells);
+    id = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (maze->isOpen(i, j)) open->insert(i, j, id++);
+        }
+    }
+    double openBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    CoordIndex* index = new CoordIndex(rows, cols, openCells);
+    id = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            if (maze->isOpen(i, j)) index->insert(i, j, id++);
+        }
+    }
+    double indexBuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    // Random probe sequence (hits and misses alike), generated once for both maps
+    int probeCount = cellCount < 4000000 ? (int)cellCount : 4000000;
+    int* probeRows = new int[probeCount];
+    int* probeCols = new int[probeCount];
+    unsigned long long state = 88172645463325252ULL;
+    for (int k = 0; k < probeCount; k++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        probeRows[k] = (int)(state % (unsigned long long)rows);
+        probeCols[k] = (int)((state >> 32) % (unsigned long long)cols);
+    }
+
+    long long chainedSum = 0, openSum = 0, indexSum = 0;
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) chainedSum += chained->get(i, j);
+        }
+    }
+    double chainedScanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) openSum += open->get(i, j);
+        }
+    }
+    double openScanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) indexSum += index->get(i, j);
+        }
+    }
+    double indexScanMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int k = 0; k < probeCount; k++) chainedSum += chained->get(probeRows[k], probeCols[k]);
+    }
+    double chainedRandomMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int k = 0; k < probeCount; k++) openSum += open->get(probeRows[k], probeCols[k]);
+    }
+    double openRandomMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int k = 0; k < probeCount; k++) indexSum += index->get(probeRows[k], probeCols[k]);
+    }
+    double indexRandomMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    double scanLookups = (double)cellCount * rounds;
+    double randomLookups = (double)probeCount * rounds;
+
+    cout << fixed << setprecision(3);
+    cout << "\nChained HashMap:" << endl;
+    cout << "  Build time: " << chainedBuildMs << " ms" << endl;
+    cout << "  Row-major lookups: " << (chainedScanMs > 0 ? scanLookups / chainedScanMs / 1000.0 : 0) << " M/s" << endl;
+    cout << "  Random lookups: " << (chainedRandomMs > 0 ? randomLookups / chainedRandomMs / 1000.0 : 0) << " M/s" << endl;
+    cout << "\nOpen addressing:" << endl;
+    cout << "  Build time: " << openBuildMs << " ms" << endl;
+    cout << "  Row-major lookups: " << (openScanMs > 0 ? scanLookups / openScanMs / 1000.0 : 0) << " M/s" << endl;
+    cout << "  Random lookups: " << (openRandomMs > 0 ? randomLookups / openRandomMs / 1000.0 : 0) << " M/s" << endl;
+    cout << "\nCoordIndex (" << (index->isDense() ? "dense array" : "open addressing") << "):" << endl;
+    cout << "  Build time: " << indexBuildMs << " ms" << endl;
+    cout << "  Row-major lookups: " << (indexScanMs > 0 ? scanLookups / indexScanMs / 1000.0 : 0) << " M/s" << endl;
+    cout << "  Random lookups: " << (indexRandomMs > 0 ? randomLookups / indexRandomMs / 1000.0 : 0) << " M/s" << endl;
+    if (openScanMs > 0 && openRandomMs > 0) {
+        cout << "\nOpen addressing vs chained: " << chainedScanMs / openScanMs << "x row-major, "
+             << chainedRandomMs / openRandomMs << "x random" << endl;
+    }
+    if (indexScanMs > 0 && indexRandomMs > 0) {
+        cout << "CoordIndex vs chained: " << chainedScanMs / indexScanMs << "x row-major, "
+             << chainedRandomMs / indexRandomMs << "x random" << endl;
+    }
+    if (chainedSum != openSum || chainedSum != indexSum) {
+        cout << "Warning: maps disagree on lookups" << endl;
+    }
+    cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "=====================================" << endl;
+
+    delete[] probeRows;
+    delete[] probeCols;
+    delete chained;
+    delete open;
+    delete index;
+
+}
+
+void benchmarkNodeOrders(Maze* maze, int rounds) {
+
+    // PURPOSE: Compare graph node numberings (see NODE ORDERING) by how far
+    // apart neighbor ids are and by the time and cache misses of BFS, A* and
+    // Dijkstra on the graph each one produces
+
+    cout << "\n=====================================" << endl;
+    cout << "   NODE ORDER BENCHMARK" << endl;
+    cout << "=====================================" << endl;
+    cout << "Maze: " << maze->getRows() << " x " << maze->getCols() << ", rounds: " << rounds << endl;
+
+    CacheMissCounter counter;
+    if (!counter.isAvailable()) {
+        cout << "(cache miss counters unavailable here; showing times only)" << endl;
+    }
+
+    const char* searchNames[] = {"BFS", "A*", "Dijkstra"};
+    cout << fixed << setprecision(3);
+
+    for (int order = 0; order < NODE_ORDER_COUNT; order++) {
+
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        MazeSolver solver(maze, false, order);
+        double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        if (solver.isImplicitGrid()) {
+            cout << "Maze has too many edges for an explicit graph; nothing to benchmark" << endl;
+            return;
+        }
+
+        // Neighbor id distance: below 16 means both ints share a cache line
+        CSRGraph* graph = solver.getGraph();
+        long long gapSum = 0, nearEdges = 0;
+        for (int u = 0; u < graph->getNodeCount(); u++) {
+            for (int e = graph->getEdgeBegin(u); e < graph->getEdgeEnd(u); e++) {
+                long long gap = graph->getEdgeDest(e) - u;
+                if (gap < 0) gap = -gap;
+                gapSum += gap;
+                if (gap < 16) nearEdges++;
+            }
+        }
+        int edges = graph->getEdgeCount();
+
+        cout << "\nOrder: " << NODE_ORDER_NAMES[order] << endl;
+        cout << "  Build time: " << buildMs << " ms" << endl;
+        cout << "  Mean neighbor id gap: " << setprecision(1) << (edges > 0 ? (double)gapSum / edges : 0.0)
+             << ", within 16 ids: " << (edges > 0 ? 100.0 * (double)nearEdges / (double)edges : 0.0) << "%" << endl;
+        cout << setprecision(3);
+
+        int* path = new int[solver.getMaxPathLength() + 1];
+        for (int search = 0; search < 3; search++) {
+
+            int pathLen = 0, nodesVisited = 0;
+            bool found = false;
+            double totalMs = 0;
+            // Either counter can fail to open or read on its own (-1)
+            long long lastLevel = 0, l1 = 0;
+            bool haveLastLevel = true, haveL1 = true;
+            for (int round = -1; round < rounds; round++) {
+
+                // Round -1 is an untimed warmup
+                counter.start();
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                if (search == 0) found = solver.solveBFS(path, pathLen, nodesVisited);
+                else if (search == 1) found = solver.solveAStar(path, pathLen, nodesVisited);
+                else found = solver.solveDijkstra(path, pathLen, nodesVisited);
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                counter.stop();
+                if (round < 0) continue;
+                totalMs += ms;
+                long long lastLevelMisses = counter.getLastLevelMisses();
+                long long l1Misses = counter.getL1Misses();
+                if (lastLevelMisses < 0) haveLastLevel = false;
+                else lastLevel += lastLevelMisses;
+                if (l1Misses < 0) haveL1 = false;
+                else l1 += l1Misses;
+
+            }
+
+            cout << "  " << searchNames[search] << ": " << totalMs / rounds << " ms";
+            if (counter.isAvailable()) {
+                cout << ", LLC misses ";
+                if (haveLastLevel) cout << lastLevel / rounds;
+                else cout << "n/a";
+                cout << ", L1D read misses ";
+                if (haveL1) cout << l1 / rounds;
+                else cout << "n/a";
+            }
+            cout << " (path " << (found ? pathLen : 0) << ", visited " << nodesVisited << ")" << endl;
+
+        }
+        delete[] path;
+
+    }
+
+    cout << "\nPeak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "=====================================" << endl;
+
+}
+
+int pickReachableQueries(Maze* maze, MazeSolver& solver, int nodes[], int queryCount) {
+
+    // PURPOSE: Fill nodes with up to queryCount (start, end) pairs of random
+    // open cells connected to S, the same ones on every run; returns the pairs made
+    ComponentLabels* components = maze->getComponents();
+    Random rng(1);
+    int picked = 0;
+    for (long long attempt = 0; picked < 2 * queryCount && attempt < 1000LL * queryCount; attempt++) {
+        int r = rng.nextInt(maze->getRows());
+        int c = rng.nextInt(maze->getCols());
+        if (!maze->isOpen(r, c) || !components->connected(maze->getStartRow(), maze->getStartCol(), r, c)) continue;
+        nodes[picked++] = solver.cellToNode(r, c);
+    }
+    return picked / 2;
+
+}
+
+void prepareLandmarks(MazeSolver& solver, Maze* maze, int count) {
+
+    // PURPOSE: Build the solver's landmarks (or adopt the stored ones) before
+    // any search and report what that preprocessing cost
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    int built = solver.buildLandmarks(count);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    LandmarkTable* table = solver.getLandmarks();
+    cout << "Landmarks: " << built << (table == maze->getStoredLandmarks() ? " (stored with the maze)" : "")
+         << " in " << fixed << setprecision(3) << ms << " ms, " << setprecision(1)
+         << (double)table->getBytesPerLandmark() / 1024.0 << " KB per landmark ("
+         << (double)(table->getBytesPerLandmark() * built) / 1024.0 << " KB total)" << endl;
+
+}
+
+long long runLandmarkQueries(MazeSolver& solver, Maze* maze, int nodes[], int pairs, int mode,
+                             int path[], long long costs[], double& ms) {
+
+    // PURPOSE: Answer query pair i (nodes[2i] to nodes[2i + 1]) with BFS
+    // (mode 0), Manhattan A* (1) or landmark A* (2); costs[i] gets the path
+    // cost. Returns the nodes expanded over all queries.
+    long long expanded = 0;
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (int i = 0; i < pairs; i++) {
+
+        int pathLen = 0, nodesVisited = 0;
+        bool found;
+        if (mode == 0) found = solver.queryBFS(nodes[2 * i], nodes[2 * i + 1], path, pathLen, nodesVisited);
+        else found = solver.queryAStar(nodes[2 * i], nodes[2 * i + 1], path, pathLen, nodesVisited, NULL, mode == 2);
+        costs[i] = found ? maze->getPathCost(path, pathLen) : -1;
+        expanded += nodesVisited;
+
+    }
+    ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    return expanded;
+
+}
+
+void benchmarkLandmarks(Maze* maze, int maxCount, int queryCount) {
+
+    // PURPOSE: Compare BFS, Manhattan A* and landmark A* with 1, 2, 4, ...
+    // maxCount landmarks on random queries within S's component: landmark
+    // preprocessing time and memory, nodes expanded and time per query
+
+    cout << "\n=====================================" << endl;
+    cout << "   LANDMARK BENCHMARK" << endl;
+    cout << "=====================================" << endl;
+
+    MazeSolver solver(maze);
+    int* nodes = new int[2 * queryCount];
+    int pairs = pickReachableQueries(maze, solver, nodes, queryCount);
+    cout << "Maze: " << maze->getRows() << " x " << maze->getCols() << ", queries: " << pairs << endl;
+
+    int* path = new int[solver.getMaxPathLength() + 1];
+    long long* bestCosts = new long long[pairs > 0 ? pairs : 1];
+    long long* costs = new long long[pairs > 0 ? pairs : 1];
+    double ms;
+    cout << fixed;
+
+    long long bfsExpanded = runLandmarkQueries(solver, maze, nodes, pairs, 0, path, costs, ms);
+    cout << "\nBFS: " << bfsExpanded << " nodes expanded, " << setprecision(3)
+         << (pairs > 0 ? ms / pairs : 0.0) << " ms per query" << endl;
+
+    long long aStarExpanded = runLandmarkQueries(solver, maze, nodes, pairs, 1, path, bestCosts, ms);
+    cout << "A* (Manhattan): " << aStarExpanded << " nodes expanded (" << setprecision(1)
+         << (bfsExpanded > 0 ? 100.0 * (double)aStarExpanded / (double)bfsExpanded : 0.0) << "% of BFS), "
+         << setprecision(3) << (pairs > 0 ? ms / pairs : 0.0) << " ms per query" << endl;
+
+    for (int count = 1; ; count = count * 2 < maxCount ? count * 2 : maxCount) {
+
+        cout << "\nA* with " << count << " landmark(s):" << endl << "  ";
+        prepareLandmarks(solver, maze, count);
+        long long expanded = runLandmarkQueries(solver, maze, nodes, pairs, 2, path, costs, ms);
+        int wrong = 0;
+        for (int i = 0; i < pairs; i++) {
+            if (costs[i] != bestCosts[i]) wrong++;
+        }
+        cout << "  " << expanded << " nodes expanded (" << setprecision(1)
+             << (bfsExpanded > 0 ? 100.0 * (double)expanded / (double)bfsExpanded : 0.0) << "% of BFS, "
+             << (aStarExpanded > 0 ? 100.0 * (double)expanded / (double)aStarExpanded : 0.0) << "% of Manhattan A*), "
+             << setprecision(3) << (pairs > 0 ? ms / pairs : 0.0) << " ms per query" << endl;
+        if (wrong > 0) cout << "  Warning: " << wrong << " path cost(s) differ from Manhattan A*" << endl;
+        if (count >= maxCount) break;
+
+    }
+
+    cout << "\nPeak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "=====================================" << endl;
+
+    delete[] nodes;
+    delete[] path;
+    delete[] bestCosts;
+    delete[] costs;
+
+}
+
+void prepareHierarchy(MazeSolver& solver) {
+
+    // PURPOSE: Build the HPA* entrance graph before any search and report its cost
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    HierarchicalGraph* h = solver.getHierarchy();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    cout << "Hierarchy: " << h->getClusterCount() << " cluster(s) of " << h->getClusterSize() << " x "
+         << h->getClusterSize() << ", " << h->getNodeCount() << " entrances, " << h->getEdgeCount()
+         << " edges in " << fixed << setprecision(3) << ms << " ms, " << setprecision(1)
+         << (double)h->getBytes() / 1024.0 << " KB" << endl;
+
+}
+
+void benchmarkHierarchy(Maze* maze, int queryCount) {
+
+    // PURPOSE: HPA* preprocessing cost against per-query latency for a range
+    // of cluster sizes, next to flat BFS, on random queries within S's component
+
+    cout << "\n=====================================" << endl;
+    cout << "   HIERARCHY BENCHMARK" << endl;
+    cout << "=====================================" << endl;
+
+    // The explicit graph is not needed; BFS on the grid gives the same paths
+    MazeSolver solver(maze, true);
+    int* nodes = new int[2 * queryCount];
+    int pairs = pickReachableQueries(maze, solver, nodes, queryCount);
+    cout << "Maze: " << maze->getRows() << " x " << maze->getCols() << ", queries: " << pairs << endl;
+
+    int* path = new int[solver.getMaxPathLength() + 1];
+    long long* bfsCosts = new long long[pairs > 0 ? pairs : 1];
+    double* latencies = new double[pairs > 0 ? pairs : 1];
+    cout << fixed;
+
+    long long expanded = 0;
+    for (int i = 0; i < pairs; i++) {
+        int pathLen = 0, nodesVisited = 0;
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        bool found = solver.queryBFS(nodes[2 * i], nodes[2 * i + 1], path, pathLen, nodesVisited);
+        latencies[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        bfsCosts[i] = found ? maze->getPathCost(path, pathLen) : -1;
+        expanded += nodesVisited;
+    }
+    mergeSort(latencies, pairs);
+    cout << "\nBFS: " << setprecision(3) << percentile(latencies, pairs, 50) << " ms median, "
+         << percentile(latencies, pairs, 99) << " ms p99, " << (pairs > 0 ? expanded / pairs : 0)
+         << " nodes per query" << endl;
+
+    // Preprocessing grows with the cluster area times its entrances, so larger sizes are left out
+    int sizes[] = {8, 16, 32, 64, 128};
+    int largest = maze->getRows() > maze->getCols() ? maze->getRows() : maze->getCols();
+    for (int s = 0; s < 5 && (s == 0 || sizes[s - 1] < largest); s++) {
+
+        solver.setClusterSize(sizes[s]);
+        cout << "\n";
+        prepareHierarchy(solver);
+
+        long long abstractTotal = 0, totalVisited = 0;
+        long long hpaCost = 0, bfsCost = 0;
+        int failed = 0;
+        for (int i = 0; i < pairs; i++) {
+            int pathLen = 0, nodesVisited = 0;
+            chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+            bool found = solver.queryHierarchical(nodes[2 * i], nodes[2 * i + 1], path, pathLen, nodesVisited);
+            latencies[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            if (!found) {
+                failed++;
+                continue;
+            }
+            abstractTotal += solver.getHierarchy()->getLastAbstractVisited();
+            totalVisited += nodesVisited;
+            hpaCost += maze->getPathCost(path, pathLen);
+            bfsCost += bfsCosts[i];
+        }
+        mergeSort(latencies, pairs);
+        int solved = pairs - failed;
+        cout << "  Query: " << setprecision(3) << percentile(latencies, pairs, 50) << " ms median, "
+             << percentile(latencies, pairs, 99) << " ms p99, " << (solved > 0 ? abstractTotal / solved : 0)
+             << " entrances + " << (solved > 0 ? (totalVisited - abstractTotal) / solved : 0)
+             << " cells expanded per query" << endl;
+        cout << "  Path cost: " << setprecision(2)
+             << (bfsCost > 0 ? 100.0 * (double)(hpaCost - bfsCost) / (double)bfsCost : 0.0)
+             << "% over BFS paths" << endl;
+        if (failed > 0) cout << "  Warning: " << failed << " queries found no path" << endl;
+
+    }
+
+    cout << "\nPeak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "=====================================" << endl;
+
+    delete[] nodes;
+    delete[] path;
+    delete[] bfsCosts;
+    delete[] latencies;
+
+}
+
+void benchmarkReplanning(Maze* maze, int editCount) {
+
+    // PURPOSE: Latency of editing one cell and repairing the S-E path with the
+    // incremental planner, against rebuilding the solver and searching again.
+    // Even edits wall up a cell of the current path, which forces a detour,
+    // or reopen the last such cell when that cut S off from E; odd edits
+    // toggle a random cell. Every replanned path is checked against the
+    // rebuilt search. The maze is edited in memory only.
+
+    cout << "\n=====================================" << endl;
+    cout << "   REPLANNING BENCHMARK" << endl;
+    cout << "=====================================" << endl;
+
+    int rows = maze->getRows(), cols = maze->getCols();
+    bool unitCosts = maze->getMaxCost() <= 1;
+    cout << "Maze: " << rows << " x " << cols << ", edits: " << editCount << endl;
+
+    int slots = editCount > 0 ? editCount : 1;
+    int* path = new int[rows * cols + 1];
+    int* rebuiltPath = new int[rows * cols + 1];
+    int* kinds = new int[slots];
+    double* replanTimes = new double[slots];
+    double* rebuildTimes = new double[slots];
+    int* replanVisited = new int[slots];
+    int* rebuildVisited = new int[slots];
+    int pathLen = 0, rebuiltLen = 0, nodesVisited = 0;
+    cout << fixed;
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    IncrementalPlanner planner(maze);
+    bool found = planner.plan(path, pathLen, nodesVisited);
+    double firstPlan = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    cout << "First plan: " << setprecision(3) << firstPlan << " ms, " << nodesVisited << " cells expanded, "
+         << (found ? "path found" : "no path") << endl;
+
+    Random rng(1);
+    int mismatches = 0;
+    int walledRow = -1, walledCol = -1;
+    for (int i = 0; i < editCount; i++) {
+
+        // An interior path cell, the last one walled, or any cell but S and E
+        kinds[i] = (i % 2 == 0 && (pathLen > 2 || walledRow >= 0)) ? 0 : 1;
+        int r, c;
+        bool makeOpen = false;
+        if (kinds[i] == 0 && pathLen > 2) {
+            int cell = path[1 + rng.nextInt(pathLen - 2)];
+            r = walledRow = cell / cols;
+            c = walledCol = cell % cols;
+        } else if (kinds[i] == 0) {
+            r = walledRow;
+            c = walledCol;
+            makeOpen = true;
+            walledRow = walledCol = -1;
+        } else {
+            do {
+                r = rng.nextInt(rows);
+                c = rng.nextInt(cols);
+            } while ((r == maze->getStartRow() && c == maze->getStartCol()) ||
+                     (r == maze->getEndRow() && c == maze->getEndCol()));
+            makeOpen = !maze->isOpen(r, c);
+        }
+
+        t0 = chrono::steady_clock::now();
+        planner.setCell(r, c, makeOpen);
+        found = planner.plan(path, pathLen, replanVisited[i]);
+        if (found) walledRow = walledCol = -1;
+        replanTimes[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+        t0 = chrono::steady_clock::now();
+        MazeSolver* solver = new MazeSolver(maze);
+        bool rebuiltFound = unitCosts ? solver->solveBFS(rebuiltPath, rebuiltLen, rebuildVisited[i])
+                                      : solver->solveDijkstra(rebuiltPath, rebuiltLen, rebuildVisited[i]);
+        rebuildTimes[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        delete solver;
+
+        if (found != rebuiltFound ||
+            (found && maze->getPathCost(path, pathLen) != maze->getPathCost(rebuiltPath, rebuiltLen))) {
+            mismatches++;
+        }
+
+    }
+
+    const char* kindNames[2] = {"Path cell walled or reopened", "Random cell toggled"};
+    double* replanSorted = new double[slots];
+    double* rebuildSorted = new double[slots];
+    for (int kind = 0; kind < 2; kind++) {
+
+        int n = 0;
+        long long replanTotal = 0, rebuildTotal = 0;
+        for (int i = 0; i < editCount; i++) {
+            if (kinds[i] != kind) continue;
+            replanSorted[n] = replanTimes[i];
+            rebuildSorted[n] = rebuildTimes[i];
+            replanTotal += replanVisited[i];
+            rebuildTotal += rebuildVisited[i];
+            n++;
+        }
+        if (n == 0) continue;
+        mergeSort(replanSorted, n);
+        mergeSort(rebuildSorted, n);
+
+        double replanMedian = percentile(replanSorted, n, 50);
+        double rebuildMedian = percentile(rebuildSorted, n, 50);
+        cout << "\n" << kindNames[kind] << " (" << n << " edits):" << endl;
+        cout << "  Replan:  " << setprecision(3) << replanMedian << " ms median, "
+             << percentile(replanSorted, n, 99) << " ms p99, " << replanTotal / n << " cells expanded" << endl;
+        cout << "  Rebuild: " << rebuildMedian << " ms median, "
+             << percentile(rebuildSorted, n, 99) << " ms p99, " << rebuildTotal / n << " nodes visited" << endl;
+        cout << "  Speedup: " << setprecision(1) << (replanMedian > 0 ? rebuildMedian / replanMedian : 0.0)
+             << "x at the median" << endl;
+
+    }
+
+    if (mismatches > 0) cout << "\nWarning: " << mismatches << " replanned paths differ from the rebuilt search" << endl;
+    else cout << "\nAll replanned paths match the rebuilt search" << endl;
+    cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "=====================================" << endl;
+
+    delete[] path;
+    delete[] rebuiltPath;
+    delete[] kinds;
+    delete[] replanTimes;
+    delete[] rebuildTimes;
+    delete[] replanVisited;
+    delete[] rebuildVisited;
+    delete[] replanSorted;
+    delete[] rebuildSorted;
+
+}
+
+// ==================== BATCH QUERIES ====================
+// PURPOSE: Answer many start/end pairs against one loaded maze
+
+struct BatchQuery {
+    int startRow, startCol, endRow, endCol;
+};
+
+struct BatchResult {
+    bool valid;            // Both endpoints are open cells
+    bool found;
+    bool rejected;         // Endpoints in different components, so no search ran
+    int pathLen;
+    long long pathCost;
+    int nodesVisited;
+    double micros;         // Latency of this query alone
+};
+
+BatchQuery* readBatchQueries(const char* filename, int& count) {
+
+    // PURPOSE: Read "startRow startCol endRow endCol" lines; blank lines and
+    // lines starting with '#' are skipped. Returns NULL on a bad file.
+    count = 0;
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error: Cannot open query file " << filename << endl;
+        return NULL;
+    }
+
+    int capacity = 1024;
+    BatchQuery* queries = new BatchQuery[capacity];
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') continue;
+
+        BatchQuery q;
+        if (sscanf(line.c_str(), "%d %d %d %d", &q.startRow, &q.startCol, &q.endRow, &q.endCol) != 4) {
+            cout << "Error: " << filename << " line " << lineNumber
+                 << ": expected 'startRow startCol endRow endCol'" << endl;
+            delete[] queries;
+            count = 0;
+            return NULL;
+        }
+
+        if (count == capacity) {
+            BatchQuery* bigger = new BatchQuery[capacity * 2];
+            for (int i = 0; i < count; i++) bigger[i] = queries[i];
+            delete[] queries;
+            queries = bigger;
+            capacity *= 2;
         }
+        queries[count++] = q;
+
     }
 
+    return queries;
+
 }
 
-void insertionSort(int arr[], int n) {
+bool runBatchQueries(Maze* maze, MazeSolver& solver, const char* queryFile, const char* resultFile,
+                     int threads, bool useAStar, int landmarkCount) {
+
+    // PURPOSE: Solve every query in queryFile with a pool of threads and write
+    // one result line per query, in input order, to resultFile
+    // A* uses landmark bounds when landmarkCount > 0
+
+    int queryCount;
+    BatchQuery* queries = readBatchQueries(queryFile, queryCount);
+    if (queries == NULL) return false;
+
+    BatchResult* results = new BatchResult[queryCount > 0 ? queryCount : 1];
+    ThreadPool pool(threads);
+    int workers = pool.getThreadCount();
+    atomic<int> nextQuery(0);
+
+    // Per-thread node pool counters, summed after the run
+    long long* poolSlabs = new long long[workers]();
+    long long* poolNodes = new long long[workers]();
+    long long* poolReused = new long long[workers]();
+
+    // Labels are built before the threads start, which then only read them
+    chrono::steady_clock::time_point labelStart = chrono::steady_clock::now();
+    ComponentLabels* components = maze->getComponents();
+    double labelMs = chrono::duration<double, milli>(chrono::steady_clock::now() - labelStart).count();
+    cout << "\nComponent labels: " << components->getComponentCount() << " component(s) in "
+         << fixed << setprecision(3) << labelMs << " ms" << endl;
+    bool useLandmarks = useAStar && landmarkCount > 0;
+    if (useLandmarks) prepareLandmarks(solver, maze, landmarkCount);
+
+    cout << "\nRunning " << queryCount << " " << (useLandmarks ? "A* (Landmarks)" : (useAStar ? "A*" : "BFS"))
+         << " queries on " << workers << " thread(s)..." << endl;
+
+    chrono::steady_clock::time_point batchStart = chrono::steady_clock::now();
+
+    pool.run([&](int tid) {
+
+        // Each thread keeps one path buffer and workspace; results go to the query's own slot
+        int* path = new int[solver.getMaxPathLength() + 1];
+        SearchWorkspace* ws = solver.createWorkspace();
+        while (true) {
+
+            int i = nextQuery.fetch_add(1);
+            if (i >= queryCount) break;
+
+            const BatchQuery& q = queries[i];
+            BatchResult& r = results[i];
+            chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+
+            int source = solver.cellToNode(q.startRow, q.startCol);
+            int target = solver.cellToNode(q.endRow, q.endCol);
+            r.valid = (source != -1 && target != -1);
+            r.found = false;
+            r.rejected = r.valid && !solver.canReach(source, target);
+            r.pathLen = 0;
+            r.pathCost = 0;
+            r.nodesVisited = 0;
+            if (r.valid && !r.rejected) {
+                r.found = useAStar
+                    ? solver.queryAStar(source, target, path, r.pathLen, r.nodesVisited, ws, useLandmarks)
+                    : solver.queryBFS(source, target, path, r.pathLen, r.nodesVisited, ws);
+                if (r.found) r.pathCost = maze->getPathCost(path, r.pathLen);
+            }
+
+            r.micros = chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count();
 
-    for (int i = 1; i < n; i++) {
-        int key = arr[i];
-        int j = i - 1;
-        while (j >= 0 && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            j--;
         }
-        arr[j + 1] = key;
+        poolSlabs[tid] = ws->getListPool()->getSlabCount();
+        poolNodes[tid] = ws->getListPool()->getCreatedCount();
+        poolReused[tid] = ws->getListPool()->getReusedCount();
+        delete ws;
+        delete[] path;
+
+    });
+
+    double totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - batchStart).count();
+
+    // Results file: one line per query, same order as the query file
+    ofstream out(resultFile);
+    out << "# startRow startCol endRow endCol status pathLength pathCost nodesVisited latencyUs\n";
+    int foundCount = 0, invalidCount = 0, rejectedCount = 0;
+    long long visitedTotal = 0;
+    for (int i = 0; i < queryCount; i++) {
+        const BatchQuery& q = queries[i];
+        const BatchResult& r = results[i];
+        visitedTotal += r.nodesVisited;
+        const char* status = !r.valid ? "invalid" : (r.found ? "ok" : "nopath");
+        if (!r.valid) invalidCount++;
+        if (r.found) foundCount++;
+        if (r.rejected) rejectedCount++;
+        out << q.startRow << " " << q.startCol << " " << q.endRow << " " << q.endCol << " "
+            << status << " " << (r.found ? r.pathLen : -1) << " " << (r.found ? r.pathCost : -1) << " "
+            << r.nodesVisited << " " << fixed << setprecision(1) << r.micros << "\n";
+    }
+    out.close();
 
+    double* latencies = new double[queryCount > 0 ? queryCount : 1];
+    for (int i = 0; i < queryCount; i++) latencies[i] = results[i].micros;
+    mergeSort(latencies, queryCount);
+
+    cout << "\n=====================================" << endl;
+    cout << "   BATCH RESULTS" << endl;
+    cout << "=====================================" << endl;
+    cout << "Queries: " << queryCount << " (found " << foundCount << ", no path "
+         << queryCount - foundCount - invalidCount << ", invalid " << invalidCount << ")" << endl;
+    cout << "Rejected by component labels: " << rejectedCount << endl;
+    cout << "Nodes visited: " << visitedTotal << " (" << fixed << setprecision(1)
+         << (queryCount > 0 ? (double)visitedTotal / queryCount : 0.0) << " per query)" << endl;
+    cout << "Total time: " << fixed << setprecision(3) << totalMs << " ms" << endl;
+    cout << "Throughput: " << fixed << setprecision(1)
+         << (totalMs > 0 ? queryCount / (totalMs / 1000.0) : 0.0) << " queries/sec" << endl;
+    cout << "Latency (us): p50 " << fixed << setprecision(1) << percentile(latencies, queryCount, 50)
+         << ", p90 " << percentile(latencies, queryCount, 90)
+         << ", p99 " << percentile(latencies, queryCount, 99)
+         << ", max " << (queryCount > 0 ? latencies[queryCount - 1] : 0.0) << endl;
+    long long slabTotal = 0, nodeTotal = 0, reusedTotal = 0;
+    for (int t = 0; t < workers; t++) {
+        slabTotal += poolSlabs[t];
+        nodeTotal += poolNodes[t];
+        reusedTotal += poolReused[t];
     }
+    cout << "List node pool: " << slabTotal << " slab allocation(s) for " << nodeTotal
+         << " nodes (" << reusedTotal << " reused from the free list)" << endl;
+    cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "\nResults saved to '" << resultFile << "'" << endl;
+
+    delete[] poolSlabs;
+    delete[] poolNodes;
+    delete[] poolReused;
+    delete[] latencies;
+    delete[] results;
+    delete[] queries;
+    return true;
+
 }
 
-// ==================== SOLVER CLASS ====================
-class MazeSolver {
-private:
+// ==================== ALGORITHM TABLE ====================
+// PURPOSE: One entry per solver, shared by the menu and the comparison mode
+
+const int ALGORITHM_COUNT = 14;
+const int LANDMARK_ALGORITHM = 12;   // A* (Landmarks), which needs its landmarks built first
+const int HIERARCHICAL_ALGORITHM = 13;   // HPA*, which needs its entrance graph built first
+const int JPS_ALGORITHM = 5;             // JPS, which only runs on uniform cell costs
+
+// The menu keeps its original numbers: 1-3 are the first three solvers and
+// 4 is Compare All. Solvers added since are numbered from 5 in table order.
+const int ORIGINAL_ALGORITHM_COUNT = 3;
+const int COMPARE_ALL_CHOICE = ORIGINAL_ALGORITHM_COUNT + 1;
+
+const char* ALGORITHM_NAMES[ALGORITHM_COUNT] = {
+    "BFS",
+    "DFS (Stack)",
+    "DFS (Recursive)",
+    "BFS (Bit-Parallel)",
+    "A*",
+    "JPS",
+    "Dijkstra",
+    "Bidirectional BFS",
+    "Direction-Optimizing BFS",
+    "Parallel BFS",
+    "Contracted Dijkstra",
+    "Contracted Dijkstra (Dead-End Filled)",
+    "A* (Landmarks)",
+    "HPA*"
+};
 
-    Maze* maze;
-    Graph* graph;
-    HashMap* coordMap;
-    int startNode, endNode;
-    
-    void buildGraph() {
+const char* ALGORITHM_DESCRIPTIONS[ALGORITHM_COUNT] = {
+    "BFS (Breadth-First Search)",
+    "DFS (Depth-First Search - Stack)",
+    "DFS (Depth-First Search - Recursive)",
+    "BFS (Bit-Parallel wavefront)",
+    "A* (Manhattan heuristic)",
+    "JPS (Jump Point Search)",
+    "Dijkstra (weighted cells, bucket queue)",
+    "Bidirectional BFS (meet in the middle)",
+    "Direction-Optimizing BFS (top-down / bottom-up)",
+    "Parallel BFS (level-synchronous, multithreaded)",
+    "Contracted Dijkstra (corridors collapsed to weighted edges)",
+    "Contracted Dijkstra after dead-end filling",
+    "A* (landmark lower bounds, ALT)",
+    "HPA* (hierarchical clusters, near-optimal)"
+};
 
-        graph = new Graph();
-        coordMap = new HashMap();
-        
-        int rows = maze->getRows();
-        int cols = maze->getCols();
-        
-        // Create nodes for all open cells
-        for (int i = 0; i < rows; i++) {
+const char* algorithmLimitation(int algorithm, Maze* maze) {
 
-            for (int j = 0; j < cols; j++) {
+    // PURPOSE: Why algorithm refuses to run on maze, or NULL when it runs
+    // The solvers just return false, so callers report this themselves
+    if (algorithm == JPS_ALGORITHM && maze->hasWeights()) {
+        return "JPS needs uniform cell costs; this maze has weighted cells";
+    }
+    return NULL;
 
-                char cell = maze->getCell(i, j);
-                if (cell == ' ' || cell == 'S' || cell == 'E') {
+}
 
-                    int nodeId = graph->addNode(i, j);
-                    coordMap->insert(i, j, nodeId);
+int menuChoice(int algorithm) {
 
-                    
-                    if (cell == 'S') startNode = nodeId;
-                    if (cell == 'E') endNode = nodeId;
-                }
-            }
-        }
-        
-        // Create edges (4-directional)
-        int dr[] = {-1, 1, 0, 0};
-        int dc[] = {0, 0, -1, 1};
-        
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                int nodeId = coordMap->get(i, j);
-                if (nodeId == -1) continue;
-                
-                for (int d = 0; d < 4; d++) {
-                    int ni = i + dr[d];
-                    int nj = j + dc[d];
+    // PURPOSE: Menu number of table entry algorithm
+    return algorithm < ORIGINAL_ALGORITHM_COUNT ? algorithm + 1 : algorithm + 2;
 
-                    int neighborId = coordMap->get(ni, nj);
-                    
-                    if (neighborId != -1) {
-                        graph->addEdge(nodeId, neighborId, 1);
-                    }
-                }
-            }
-        }
-    }
-    
-    int reconstructPath(int parent[], int path[]) {
-        int pathLen = 0;
-        int curr = endNode;
-        
-        StackArray pathStack;
-        while (curr != -1) {
+}
 
-            pathStack.push(curr);
-            curr = parent[curr];
+int menuAlgorithm(int choice) {
 
-        }
-        
-        while (!pathStack.isEmpty()) {
+    // PURPOSE: Table entry picked by menu number choice, or -1 for Compare All
+    // and numbers that pick nothing
+    int algorithm = choice <= ORIGINAL_ALGORITHM_COUNT ? choice - 1 : choice - 2;
+    return choice != COMPARE_ALL_CHOICE && algorithm >= 0 && algorithm < ALGORITHM_COUNT ? algorithm : -1;
 
-            int node = pathStack.pop();
-            int r, c;
-            graph->getNodeCoords(node, r, c);
-            path[pathLen++] = r * MAX_COLS + c;
+}
 
-        }
-        
-        return pathLen;
+bool runAlgorithm(MazeSolver& solver, int algorithm, int path[], int& pathLen, int& nodesVisited) {
+
+    // Nothing to search when the component labels already say there is no
+    // path, or when the solver is stale (see MazeSolver::isStale)
+    if (algorithm >= 0 && algorithm < ALGORITHM_COUNT && !solver.isEndReachable()) {
+        pathLen = 0;
+        nodesVisited = 0;
+        return false;
     }
-    
-public:
-    MazeSolver(Maze* m) : maze(m), graph(NULL), coordMap(NULL) {
-        buildGraph();
+
+    switch (algorithm) {
+        case 0: return solver.solveBFS(path, pathLen, nodesVisited);
+        case 1: return solver.solveDFSStack(path, pathLen, nodesVisited);
+        case 2: return solver.solveDFSRecursive(path, pathLen, nodesVisited);
+        case 3: return solver.solveBFSBitParallel(path, pathLen, nodesVisited);
+        case 4: return solver.solveAStar(path, pathLen, nodesVisited);
+        case 5: return solver.solveJPS(path, pathLen, nodesVisited);
+        case 6: return solver.solveDijkstra(path, pathLen, nodesVisited);
+        case 7: return solver.solveBidirectionalBFS(path, pathLen, nodesVisited);
+        case 8: return solver.solveDirectionOptimizingBFS(path, pathLen, nodesVisited);
+        case 9: return solver.solveParallelBFS(path, pathLen, nodesVisited);
+        case 10: return solver.solveContracted(path, pathLen, nodesVisited);
+        case 11: return solver.solveContracted(path, pathLen, nodesVisited, true);
+        case 12: return solver.solveLandmarkAStar(path, pathLen, nodesVisited);
+        case 13: return solver.solveHierarchical(path, pathLen, nodesVisited);
     }
-    
-    // BFS Algorithm using Queue
+    pathLen = 0;
+    nodesVisited = 0;
+    return false;
 
-    bool solveBFS(int path[], int& pathLen, int& nodesVisited) {
+}
 
-        int nodeCount = graph->getNodeCount();
-        bool visited[MAX_NODES] = {false};
-        int parent[MAX_NODES];
-        for (int i = 0; i < nodeCount; i++) parent[i] = -1;
-        
-        QueueLinkedList q;
-        q.enqueue(startNode);
-        visited[startNode] = true;
-        nodesVisited = 0;
-        
-        while (!q.isEmpty()) {
+// ==================== DISTANCE FIELD EXPORT ====================
+// PURPOSE: Write the nearest-exit distance field of a maze (see DISTANCE FIELD)
+// USED IN: --distance-field
 
-            int curr = q.dequeue();
-            nodesVisited++;
-            
-            if (curr == endNode) {
+int* readTargetCells(const char* filename, Maze* maze, int& count) {
 
-                pathLen = reconstructPath(parent, path);
-                return true;
+    // PURPOSE: Read "row col" lines as row * cols + col cells; blank lines and
+    // lines starting with '#' are skipped. Returns NULL on a bad file.
+    count = 0;
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error: Cannot open target file " << filename << endl;
+        return NULL;
+    }
 
-            }
-            
-            AdjListNode* adj = graph->getAdjList(curr);
-            while (adj != NULL) {
-                int neighbor = adj->dest;
-                if (!visited[neighbor]) {
-                    visited[neighbor] = true;
-                    parent[neighbor] = curr;
-                    q.enqueue(neighbor);
-                }
-                adj = adj->next;
-            }
+    int capacity = 1024;
+    int* cells = new int[capacity];
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == string::npos || line[first] == '#') continue;
+
+        int r, c;
+        if (sscanf(line.c_str(), "%d %d", &r, &c) != 2 ||
+            r < 0 || r >= maze->getRows() || c < 0 || c >= maze->getCols()) {
+            cout << "Error: " << filename << " line " << lineNumber
+                 << ": expected 'row col' inside the maze" << endl;
+            delete[] cells;
+            count = 0;
+            return NULL;
         }
-        
-        pathLen = 0;
-        return false;
+
+        if (count == capacity) {
+            int* bigger = new int[capacity * 2];
+            memcpy(bigger, cells, sizeof(int) * (size_t)count);
+            delete[] cells;
+            cells = bigger;
+            capacity *= 2;
+        }
+        cells[count++] = r * maze->getCols() + c;
+
     }
-    
-    // DFS Algorithm using Stack
-    bool solveDFSStack(int path[], int& pathLen, int& nodesVisited) {
 
-        int nodeCount = graph->getNodeCount();
+    return cells;
 
-        bool visited[MAX_NODES] = {false};
-        int parent[MAX_NODES];
-        for (int i = 0; i < nodeCount; i++) parent[i] = -1;
+}
 
-        
-        StackLinkedList s;
-        s.push(startNode);
-        nodesVisited = 0;
-        
+bool runDistanceField(Maze* maze, const char* outFile, const char* targetFile, int threads) {
 
+    // PURPOSE: Compute the distance field from every E cell (plus the cells
+    // in targetFile, if not NULL) and write it to outFile
 
-        while (!s.isEmpty()) {
+    int targetCount = 0;
+    int* targets = NULL;
+    if (targetFile != NULL) {
+        targets = readTargetCells(targetFile, maze, targetCount);
+        if (targets == NULL) return false;
+    }
 
-            int curr = s.pop();
-            
-            if (visited[curr]) continue;
-            visited[curr] = true;
-            nodesVisited++;
-            
-            if (curr == endNode) {
+    int exitCount = maze->getExitCount();
+    int* sources = new int[exitCount + targetCount];
+    memcpy(sources, maze->getExitCells(), sizeof(int) * (size_t)exitCount);
+    if (targetCount > 0) memcpy(sources + exitCount, targets, sizeof(int) * (size_t)targetCount);
+    delete[] targets;
+
+    ThreadPool* pool = threads > 1 ? new ThreadPool(threads) : NULL;
+    cout << "\nComputing distance field from " << exitCount << " exit(s)";
+    if (targetFile != NULL) cout << " and " << targetCount << " target(s)";
+    cout << " on " << (pool != NULL ? pool->getThreadCount() : 1) << " thread(s)..." << endl;
+
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    DistanceField field(maze);
+    int used = field.compute(sources, exitCount + targetCount, pool);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    delete pool;
+
+    cout << "Sources: " << used << " open cell(s)";
+    if (used < exitCount + targetCount) cout << " (" << exitCount + targetCount - used << " walls or repeats skipped)";
+    cout << endl;
+    cout << "Reached: " << field.getReachedCount() << " cell(s), farthest " << field.getMaxDistance()
+         << " steps from a source" << endl;
+    cout << "Time: " << fixed << setprecision(3) << ms << " ms" << endl;
+
+    long long fileSize = 0;
+    bool ok = field.write(outFile, fileSize);
+    if (ok) {
+        cout << "Distance field written to " << outFile << " (" << fileSize << " bytes, "
+             << (field.getMaxDistance() < 0xFFFF ? 2 : 4) << "-byte distances)" << endl;
+    }
+    cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
 
+    delete[] sources;
+    return ok;
 
-                pathLen = reconstructPath(parent, path);
-                return true;
-            }
-            
-            AdjListNode* adj = graph->getAdjList(curr);
-            while (adj != NULL) {
-                int neighbor = adj->dest;
-                if (!visited[neighbor]) {
+}
 
-                    parent[neighbor] = curr;
-                    s.push(neighbor);
+// ==================== BENCHMARK SUITE ====================
+// PURPOSE: Run every solver over a set of mazes with warmup and repeated
+// timed runs, and write the statistics as CSV and JSON for comparing builds
+
+char* buildRandomMazeText(int rows, int cols, double wallDensity, unsigned long long seed, long long& len) {
+
+    // PURPOSE: Text of a maze with a wall border and independently placed
+    // walls inside; S is at the top-left corner and E at the bottom-right
+    // (the maze needs at least 3 rows and columns)
+    Random rng(seed);
+    len = (long long)rows * (cols + 1);
+    char* text = new char[len];
+    for (int r = 0; r < rows; r++) {
+        char* line = text + (long long)r * (cols + 1);
+        for (int c = 0; c < cols; c++) {
+            bool border = (r == 0 || r == rows - 1 || c == 0 || c == cols - 1);
+            line[c] = (border || rng.nextDouble() < wallDensity) ? '#' : ' ';
+        }
+        line[cols] = '\n';
+    }
+    // Clear the 2x2 inside corners so S and E are never walled in on their own
+    for (int r = 1; r <= 2 && r < rows - 1; r++) {
+        for (int c = 1; c <= 2 && c < cols - 1; c++) {
+            text[(long long)r * (cols + 1) + c] = ' ';
+            text[(long long)(rows - 1 - r) * (cols + 1) + (cols - 1 - c)] = ' ';
+        }
+    }
+    text[(long long)1 * (cols + 1) + 1] = 'S';
+    text[(long long)(rows - 2) * (cols + 1) + cols - 2] = 'E';
+    return text;
 
-                }
-                adj = adj->next;
+}
+
+void writeJsonString(ostream& out, const char* text) {
+
+    out << '"';
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') out << '\\';
+        out << *p;
+    }
+    out << '"';
+
+}
+
+struct BenchCase {
+    char name[64];
+    int rows, cols;
+    const char* generator;  // Maze generator, or NULL for random walls
+    double wallDensity;     // Random walls only; -1 for a maze loaded from a file
+};
 
+bool runBenchmarkSuite(const char* mazeFile, int warmup, int reps, int threads,
+                       const char* csvFile, const char* jsonFile) {
+
+    // PURPOSE: Benchmark all solvers on mazeFile, or on the generated corpus when it is NULL
+    // False when mazeFile does not load or no case produced results, so a
+    // harness never mistakes an empty run for a successful one
+
+    // Corpus: every size with random walls at each density, plus one maze
+    // from each listed generator (odd sizes so perfect mazes fill the grid)
+    const int SIZE_COUNT = 3;
+    const int DENSITY_COUNT = 3;
+    const int KIND_COUNT = 3;
+    int sizes[SIZE_COUNT] = {129, 513, 2049};
+    double densities[DENSITY_COUNT] = {0.0, 0.2, 0.3};
+    const char* kinds[KIND_COUNT] = {"backtracker", "braided", "rooms"};
+
+    int caseCount = mazeFile != NULL ? 1 : SIZE_COUNT * (DENSITY_COUNT + KIND_COUNT);
+    BenchCase* cases = new BenchCase[caseCount];
+    if (mazeFile != NULL) {
+        snprintf(cases[0].name, sizeof(cases[0].name), "%s", mazeFile);
+        cases[0].generator = NULL;
+        cases[0].wallDensity = -1;
+    } else {
+        int k = 0;
+        for (int si = 0; si < SIZE_COUNT; si++) {
+            for (int di = 0; di < DENSITY_COUNT; di++) {
+                BenchCase& bc = cases[k++];
+                bc.rows = bc.cols = sizes[si];
+                bc.generator = NULL;
+                bc.wallDensity = densities[di];
+                snprintf(bc.name, sizeof(bc.name), "random-%dx%d-d%.2f", bc.rows, bc.cols, bc.wallDensity);
+            }
+            for (int gi = 0; gi < KIND_COUNT; gi++) {
+                BenchCase& bc = cases[k++];
+                bc.rows = bc.cols = sizes[si];
+                bc.generator = kinds[gi];
+                bc.wallDensity = 0;
+                snprintf(bc.name, sizeof(bc.name), "%s-%dx%d", bc.generator, bc.rows, bc.cols);
             }
         }
-        
-        pathLen = 0;
+    }
+
+    ofstream csv(csvFile);
+    ofstream json(jsonFile);
+    if (!csv.is_open() || !json.is_open()) {
+        cout << "Error: Cannot write benchmark output" << endl;
+        delete[] cases;
         return false;
     }
-    
-    // DFS Recursive
-    bool dfsRecursiveHelper(int curr, bool visited[], int parent[], int& nodesVisited) {
-        visited[curr] = true;
-        nodesVisited++;
-        
-        if (curr == endNode) {
 
-            return true;
+    csv << fixed << setprecision(4);
+    json << fixed << setprecision(4);
+    csv << "maze,rows,cols,wall_density,algorithm,found,path_length,nodes_visited,reps,"
+        << "min_ms,median_ms,p90_ms,p99_ms,nodes_per_sec\n";
+    json << "{\n  \"warmup\": " << warmup << ",\n  \"reps\": " << reps
+         << ",\n  \"threads\": " << threads << ",\n  \"results\": [";
+    bool firstRecord = true;
 
+    cout << "\n=====================================" << endl;
+    cout << "   BENCHMARK SUITE" << endl;
+    cout << "=====================================" << endl;
+    cout << "Warmup runs: " << warmup << ", timed runs: " << reps << ", threads: " << threads << endl;
+
+    double* times = new double[reps];
+    bool loadFailed = false;
+    for (int ci = 0; ci < caseCount; ci++) {
+
+        BenchCase& bc = cases[ci];
+        Maze maze;
+        MazeSolver* solver = NULL;
+        if (bc.wallDensity < 0) {
+            if (!maze.loadFromFile(mazeFile)) {
+                loadFailed = true;
+                break;
+            }
+            solver = new MazeSolver(&maze);
+        } else if (bc.generator != NULL) {
+            // Generated mazes always connect S and E
+            char* text = new char[(long long)bc.rows * (bc.cols + 1)];
+            MazeOutput out(text);
+            bool loaded = generateMaze(bc.generator, bc.rows, bc.cols, (unsigned long long)(1000 + ci), -1, out) &&
+                          maze.loadFromText(text, out.getLength());
+            delete[] text;
+            if (!loaded) continue;
+            solver = new MazeSolver(&maze);
+        } else {
+            // Random walls can cut S off from E; try further seeds until they connect
+            for (int attempt = 0; attempt < 50 && solver == NULL; attempt++) {
+                long long len;
+                char* text = buildRandomMazeText(bc.rows, bc.cols, bc.wallDensity,
+                                                 (unsigned long long)(1000 + ci * 50 + attempt), len);
+                bool loaded = maze.loadFromText(text, len);
+                delete[] text;
+                if (!loaded) break;
+                solver = new MazeSolver(&maze);
+                int pathLen, nodesVisited;
+                if (!solver->queryBFS(solver->cellToNode(maze.getStartRow(), maze.getStartCol()),
+                                      solver->cellToNode(maze.getEndRow(), maze.getEndCol()),
+                                      NULL, pathLen, nodesVisited)) {
+                    delete solver;
+                    solver = NULL;
+                }
+            }
+            if (solver == NULL) {
+                cout << "\n" << bc.name << ": no solvable maze generated, skipped" << endl;
+                continue;
+            }
         }
-        
-        AdjListNode* adj = graph->getAdjList(curr);
-        while (adj != NULL) {
+        bc.rows = maze.getRows();
+        bc.cols = maze.getCols();
 
-            int neighbor = adj->dest;
-            if (!visited[neighbor]) {
+        solver->setThreadCount(threads);
+        int* path = new int[solver->getMaxPathLength() + 1];
 
-                parent[neighbor] = curr;
-                if (dfsRecursiveHelper(neighbor, visited, parent, nodesVisited)) {
-                    return true;
-                }
+        cout << "\n" << bc.name << " (" << bc.rows << " x " << bc.cols << ")" << endl;
+        cout << left << setw(26) << "Algorithm" << right << setw(8) << "Path" << setw(11) << "Visited"
+             << setw(12) << "Median ms" << setw(11) << "p90 ms" << setw(11) << "p99 ms"
+             << setw(14) << "M nodes/s" << endl;
+
+        for (int a = 0; a < ALGORITHM_COUNT; a++) {
+
+            int pathLen = 0, nodesVisited = 0;
+            bool found = false;
+            for (int w = 0; w < warmup; w++) {
+                found = runAlgorithm(*solver, a, path, pathLen, nodesVisited);
+            }
+            for (int rep = 0; rep < reps; rep++) {
+                chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+                found = runAlgorithm(*solver, a, path, pathLen, nodesVisited);
+                times[rep] = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
             }
-            adj = adj->next;
+
+            mergeSort(times, reps);
+            double median = percentile(times, reps, 50);
+            double p90 = percentile(times, reps, 90);
+            double p99 = percentile(times, reps, 99);
+            double nodesPerSec = median > 0 ? nodesVisited / (median / 1000.0) : 0;
+
+            cout << left << setw(26) << ALGORITHM_NAMES[a] << right << setw(8) << (found ? pathLen : -1)
+                 << setw(11) << nodesVisited << fixed << setprecision(3) << setw(12) << median
+                 << setw(11) << p90 << setw(11) << p99 << setw(14) << nodesPerSec / 1e6 << endl;
+
+            csv << bc.name << "," << bc.rows << "," << bc.cols << ","
+                << (bc.wallDensity < 0 ? 0.0 : bc.wallDensity) << "," << ALGORITHM_NAMES[a] << ","
+                << (found ? 1 : 0) << "," << (found ? pathLen : -1) << "," << nodesVisited << "," << reps << ","
+                << times[0] << "," << median << "," << p90 << "," << p99 << "," << setprecision(0) << nodesPerSec
+                << setprecision(4) << "\n";
+
+            json << (firstRecord ? "\n" : ",\n") << "    {\"maze\": ";
+            writeJsonString(json, bc.name);
+            json << ", \"rows\": " << bc.rows << ", \"cols\": " << bc.cols << ", \"algorithm\": ";
+            writeJsonString(json, ALGORITHM_NAMES[a]);
+            json << ", \"found\": " << (found ? "true" : "false") << ", \"path_length\": " << (found ? pathLen : -1)
+                 << ", \"nodes_visited\": " << nodesVisited << ", \"min_ms\": " << times[0]
+                 << ", \"median_ms\": " << median << ", \"p90_ms\": " << p90 << ", \"p99_ms\": " << p99
+                 << ", \"nodes_per_sec\": " << setprecision(0) << nodesPerSec << setprecision(4) << "}";
+            firstRecord = false;
+
         }
-        
-        return false;
+
+        delete[] path;
+        delete solver;
+
     }
-    
-    bool solveDFSRecursive(int path[], int& pathLen, int& nodesVisited) {
 
-        int nodeCount = graph->getNodeCount();
-        bool visited[MAX_NODES] = {false};
-        int parent[MAX_NODES];
-        for (int i = 0; i < nodeCount; i++) parent[i] = -1;
-        
-        nodesVisited = 0;
-        
-        if (dfsRecursiveHelper(startNode, visited, parent, nodesVisited)) {
-            pathLen = reconstructPath(parent, path);
-            return true;
-        }
-        
-        pathLen = 0;
+    json << "\n  ]\n}\n";
+    csv.close();
+    json.close();
+
+    delete[] times;
+    delete[] cases;
+
+    if (loadFailed || firstRecord) {
+        cout << "\nError: " << (loadFailed ? "The maze did not load" : "No benchmark case produced results")
+             << "; '" << csvFile << "' and '" << jsonFile << "' hold no data" << endl;
         return false;
     }
-    
-    ~MazeSolver() {
-        delete graph;
-        delete coordMap;
-    }
-};
+
+    cout << "\nPeak memory: " << getPeakMemoryKB() << " KB" << endl;
+    cout << "Results saved to '" << csvFile << "' and '" << jsonFile << "'" << endl;
+    return true;
+
+}
 
 // ==================== MAIN PROGRAM ====================
 
-int main() {
+int main(int argc, char* argv[]) {
 
     cout << "=====================================" << endl;
     cout << "   MAZE SOLVER - DSA PROJECT" << endl;
     cout << "=====================================" << endl;
 
+    // Command line: [--bench-graph] [--bench-hash] [--implicit] [--threads N]
+    //               [--batch queries.txt [--batch-out results.txt] [--batch-algo bfs|astar|alt]]
+    //               [--bench [--bench-warmup N] [--bench-reps N] [--bench-csv file] [--bench-json file]]
+    //               [--generate ALGORITHM ROWS COLS out.txt [--seed N] [--braid P]]
+    //               [--convert out.mzb [--with-graph] [--with-components] [--with-landmarks]]
+    //               [--order ORDER] [--bench-order] [--landmarks K] [--bench-landmarks]
+    //               [--cluster-size N] [--bench-hpa] [--bench-replan]
+    //               [--distance-field out.dist [--targets targets.txt]] [maze_file]
+    // maze_file defaults to input_maze.txt
+    // --bench times every solver on a generated corpus (or on maze_file if given)
+    // --generate backtracker|prim|kruskal|braided|rooms ROWS COLS out.txt [--seed N] [--braid P]
+    //   writes a generated maze instead of solving one
+    // --convert saves maze_file in the binary maze format, which loads without
+    //   parsing; --with-graph also stores the solver graph so it is not rebuilt,
+    //   --with-components the connected-component labels, --with-landmarks the
+    //   landmark distance tables
+    // --order rowmajor|morton|hilbert|bfs numbers the graph nodes along that
+    //   order (default rowmajor); --bench-order compares all of them
+    // --landmarks sets how many landmarks A* (Landmarks), --batch-algo alt and
+    //   --with-landmarks use (default 8); --bench-landmarks compares 1, 2, 4, ...
+    //   of them with BFS and Manhattan A* on random queries
+    // --cluster-size sets the cluster side length of HPA* (default 32);
+    //   --bench-hpa compares cluster sizes against flat BFS on random queries
+    // --bench-replan edits cells one at a time and times the incremental
+    //   replan against rebuilding the solver and searching again
+    // --distance-field writes every cell's distance to the nearest E (and next
+    //   hop) instead of solving; --targets adds the "row col" cells of a file
+    //   as extra exits. Uses --threads
+    // --implicit searches the grid directly instead of building a graph
+    // --threads sets the thread count of the parallel solvers (default: all cores)
+    // --batch answers every query in the file instead of showing the menu
+    const char* mazeFile = "input_maze.txt";
+    bool mazeFileGiven = false;
+    bool benchGraph = false;
+    bool benchHash = false;
+    bool benchOrder = false;
+    int nodeOrder = NODE_ORDER_ROW_MAJOR;
+    bool benchSuite = false;
+    const char* generateAlgorithm = NULL;
+    int generateRows = 0, generateCols = 0;
+    const char* generateFile = NULL;
+    const char* convertFile = NULL;
+    bool convertGraph = false;
+    bool convertComponents = false;
+    bool convertLandmarks = false;
+    int landmarkCount = DEFAULT_LANDMARK_COUNT;
+    bool benchLandmarks = false;
+    int clusterSize = DEFAULT_CLUSTER_SIZE;
+    bool benchHierarchy = false;
+    bool benchReplan = false;
+    unsigned long long seed = 1;
+    double braidChance = -1;
+    int benchWarmup = 2;
+    int benchReps = 10;
+    const char* benchCsv = "bench_results.csv";
+    const char* benchJson = "bench_results.json";
+    bool implicitGrid = false;
+    int threads = defaultThreadCount();
+    const char* batchFile = NULL;
+    const char* distanceFile = NULL;
+    const char* targetFile = NULL;
+    const char* batchOut = "batch_results.txt";
+    bool batchAStar = false;
+    bool batchLandmarks = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench-graph") == 0) {
+            benchGraph = true;
+        } else if (strcmp(argv[i], "--bench-hash") == 0) {
+            benchHash = true;
+        } else if (strcmp(argv[i], "--bench-order") == 0) {
+            benchOrder = true;
+        } else if (strcmp(argv[i], "--order") == 0 && i + 1 < argc) {
+            nodeOrder = findNodeOrder(argv[++i]);
+            if (nodeOrder < 0) {
+                cout << "--order must be rowmajor, morton, hilbert or bfs" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--generate") == 0 && i + 4 < argc) {
+            generateAlgorithm = argv[++i];
+            generateRows = atoi(argv[++i]);
+            generateCols = atoi(argv[++i]);
+            generateFile = argv[++i];
+        } else if (strcmp(argv[i], "--convert") == 0 && i + 1 < argc) {
+            convertFile = argv[++i];
+        } else if (strcmp(argv[i], "--with-graph") == 0) {
+            convertGraph = true;
+        } else if (strcmp(argv[i], "--with-components") == 0) {
+            convertComponents = true;
+        } else if (strcmp(argv[i], "--with-landmarks") == 0) {
+            convertLandmarks = true;
+        } else if (strcmp(argv[i], "--landmarks") == 0 && i + 1 < argc) {
+            landmarkCount = atoi(argv[++i]);
+            if (landmarkCount < 1) {
+                cout << "--landmarks needs a positive number" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-landmarks") == 0) {
+            benchLandmarks = true;
+        } else if (strcmp(argv[i], "--cluster-size") == 0 && i + 1 < argc) {
+            clusterSize = atoi(argv[++i]);
+            if (clusterSize < 2) {
+                cout << "--cluster-size needs a number of at least 2" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-hpa") == 0) {
+            benchHierarchy = true;
+        } else if (strcmp(argv[i], "--bench-replan") == 0) {
+            benchReplan = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--braid") == 0 && i + 1 < argc) {
+            braidChance = atof(argv[++i]);
+            if (braidChance < 0 || braidChance > 1) {
+                cout << "--braid needs a probability between 0 and 1" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            benchSuite = true;
+        } else if (strcmp(argv[i], "--bench-warmup") == 0 && i + 1 < argc) {
+            benchWarmup = atoi(argv[++i]);
+            if (benchWarmup < 0) benchWarmup = 0;
+        } else if (strcmp(argv[i], "--bench-reps") == 0 && i + 1 < argc) {
+            benchReps = atoi(argv[++i]);
+            if (benchReps < 1) {
+                cout << "--bench-reps needs a positive number" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bench-csv") == 0 && i + 1 < argc) {
+            benchCsv = argv[++i];
+        } else if (strcmp(argv[i], "--bench-json") == 0 && i + 1 < argc) {
+            benchJson = argv[++i];
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batchFile = argv[++i];
+        } else if (strcmp(argv[i], "--distance-field") == 0 && i + 1 < argc) {
+            distanceFile = argv[++i];
+        } else if (strcmp(argv[i], "--targets") == 0 && i + 1 < argc) {
+            targetFile = argv[++i];
+        } else if (strcmp(argv[i], "--batch-out") == 0 && i + 1 < argc) {
+            batchOut = argv[++i];
+        } else if (strcmp(argv[i], "--batch-algo") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "astar") == 0) {
+                batchAStar = true;
+            } else if (strcmp(argv[i], "alt") == 0) {
+                batchAStar = true;
+                batchLandmarks = true;
+            } else if (strcmp(argv[i], "bfs") != 0) {
+                cout << "--batch-algo must be bfs, astar or alt" << endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--implicit") == 0) {
+            implicitGrid = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            if (threads < 1) {
+                cout << "--threads needs a positive number" << endl;
+                return 1;
+            }
+        } else if (argv[i][0] == '-') {
+            cout << "Unknown option: " << argv[i] << endl;
+            return 1;
+        } else {
+            mazeFile = argv[i];
+            mazeFileGiven = true;
+        }
+    }
+    
+    if (generateAlgorithm != NULL) {
+        ofstream file(generateFile, ios::binary);
+        if (!file.is_open()) {
+            cout << "Error: Cannot write " << generateFile << endl;
+            return 1;
+        }
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        MazeOutput out(&file);
+        bool ok = generateMaze(generateAlgorithm, generateRows, generateCols, seed, braidChance, out);
+        file.close();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        if (!ok) return 1;
+        long long bytes = (long long)generateRows * (generateCols + 1);
+        cout << "\nGenerated " << generateAlgorithm << " maze " << generateRows << " x " << generateCols
+             << " (" << (long long)generateRows * generateCols << " cells, seed " << seed << ") into "
+             << generateFile << endl;
+        cout << "Time: " << fixed << setprecision(3) << ms << " ms ("
+             << setprecision(1) << (ms > 0 ? (double)bytes / ms / 1000.0 : 0.0) << " MB/s)" << endl;
+        cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
+        return 0;
+    }
+
+    if (benchSuite) {
+        // The generated corpus is used unless a maze file is named
+        return runBenchmarkSuite(mazeFileGiven ? mazeFile : NULL, benchWarmup, benchReps, threads,
+                                 benchCsv, benchJson) ? 0 : 1;
+    }
     
     Maze maze;
     
     // Load maze from file
-    if (!maze.loadFromFile("input_maze.txt")) {
+    if (!maze.loadFromFile(mazeFile)) {
+
+        // Only fall back to the sample maze when no file was requested
+        if (mazeFileGiven) {
+            return 1;
+        }
 
         cout << "\nCreating sample maze file 'input_maze.txt'..." << endl;
         
@@ -838,71 +8879,143 @@ int main() {
         }
     }
     
+    cout << "\nMaze loaded" << (maze.isBinary() ? " (binary)" : "") << ": " << fixed << setprecision(1)
+         << (double)maze.getLoadBytes() / 1048576.0 << " MB in " << setprecision(3) << maze.getLoadMs() << " ms";
+    if (maze.isBinary()) {
+        // Mapped pages are only read when first touched, so a rate means nothing here
+        cout << endl;
+    } else {
+        cout << " (" << (maze.getLoadMs() > 0 ? (double)maze.getLoadBytes() / (maze.getLoadMs() * 1e6) : 0.0)
+             << " GB/s)" << endl;
+    }
+    
+    if (convertFile != NULL) {
+        chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+        // The stored graph and landmarks come from a row-major solver, the numbering the file uses
+        MazeSolver* graphSource = convertGraph || convertLandmarks ? new MazeSolver(&maze) : NULL;
+        if (graphSource != NULL && graphSource->isImplicitGrid()) {
+            cout << "Error: Maze has too many edges to store a graph or landmarks" << endl;
+            delete graphSource;
+            return 1;
+        }
+        if (convertLandmarks) prepareLandmarks(*graphSource, &maze, landmarkCount);
+        long long fileSize = 0;
+        bool ok = writeBinaryMaze(&maze, convertGraph ? graphSource->getGraph() : NULL,
+                                  convertComponents ? maze.getComponents() : NULL,
+                                  convertLandmarks ? graphSource->getLandmarks() : NULL, convertFile, fileSize);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        delete graphSource;
+        if (!ok) return 1;
+        cout << "\nWrote " << convertFile << ": " << fixed << setprecision(1) << (double)fileSize / 1048576.0
+             << " MB" << (convertGraph ? " with graph" : "") << (convertComponents ? " with components" : "")
+             << (convertLandmarks ? " with landmarks" : "")
+             << " in " << setprecision(3) << ms << " ms" << endl;
+        return 0;
+    }
+
+    if (benchGraph || benchHash || benchOrder || benchLandmarks || benchHierarchy || benchReplan) {
+        if (benchGraph) benchmarkGraphBackends(&maze, 5);
+        if (benchHash) benchmarkCoordMaps(&maze, 5);
+        if (benchOrder) benchmarkNodeOrders(&maze, 5);
+        if (benchLandmarks) benchmarkLandmarks(&maze, landmarkCount, 200);
+        if (benchHierarchy) benchmarkHierarchy(&maze, 200);
+        // Last, since it edits the maze
+        if (benchReplan) benchmarkReplanning(&maze, 40);
+        return 0;
+    }
+    
+    if (distanceFile != NULL) {
+        return runDistanceField(&maze, distanceFile, targetFile, threads) ? 0 : 1;
+    }
+
+    if (batchFile != NULL) {
+        chrono::steady_clock::time_point setupStart = chrono::steady_clock::now();
+        MazeSolver batchSolver(&maze, implicitGrid, nodeOrder);
+        double setupMs = chrono::duration<double, milli>(chrono::steady_clock::now() - setupStart).count();
+        cout << "\nSolver setup (" << (batchSolver.isImplicitGrid() ? "implicit grid" : "explicit graph") << "): "
+             << fixed << setprecision(3) << setupMs << " ms" << endl;
+        return runBatchQueries(&maze, batchSolver, batchFile, batchOut, threads, batchAStar,
+                               batchLandmarks ? landmarkCount : 0) ? 0 : 1;
+    }
+    
     cout << "\nOriginal Maze:" << endl;
-    maze.display();
+    if ((long long)maze.getRows() * maze.getCols() <= MAX_DISPLAY_CELLS) {
+        maze.display();
+    } else {
+        cout << "(" << maze.getRows() << " x " << maze.getCols() << " maze, too large to display)" << endl;
+    }
     
-    MazeSolver solver(&maze);
+    chrono::steady_clock::time_point setupStart = chrono::steady_clock::now();
+    MazeSolver solver(&maze, implicitGrid, nodeOrder);
+    solver.setThreadCount(threads);
+    solver.setClusterSize(clusterSize);
+    double setupTime = chrono::duration<double, milli>(chrono::steady_clock::now() - setupStart).count();
+    cout << "\nSolver setup (" << (solver.isImplicitGrid() ? "implicit grid" : "explicit graph") << "): "
+         << fixed << setprecision(3) << setupTime << " ms" << endl;
+
+    // Labelled up front so the first search's time does not include them
+    chrono::steady_clock::time_point labelStart = chrono::steady_clock::now();
+    int componentCount = maze.getComponents()->getComponentCount();
+    cout << "Component labels: " << componentCount << " component(s) in "
+         << chrono::duration<double, milli>(chrono::steady_clock::now() - labelStart).count() << " ms" << endl;
     
     cout << "\n=====================================" << endl;
     cout << "SELECT ALGORITHM:" << endl;
-    cout << "1. BFS (Breadth-First Search)" << endl;
-    cout << "2. DFS (Depth-First Search - Stack)" << endl;
-    cout << "3. DFS (Depth-First Search - Recursive)" << endl;
-    cout << "4. Compare All Algorithms" << endl;
+    for (int i = 0; i < ALGORITHM_COUNT; i++) {
+        if (menuChoice(i) == COMPARE_ALL_CHOICE + 1) cout << COMPARE_ALL_CHOICE << ". Compare All Algorithms" << endl;
+        cout << menuChoice(i) << ". " << ALGORITHM_DESCRIPTIONS[i] << endl;
+    }
     cout << "=====================================" << endl;
     cout << "Enter choice: ";
     
     int choice;
     cin >> choice;
+    int algorithm = menuAlgorithm(choice);
+
+    // Landmarks and the HPA* hierarchy are preprocessing too, so they are
+    // built and reported before any timed search
+    bool compareAll = choice == COMPARE_ALL_CHOICE;
+    bool needLandmarks = compareAll || algorithm == LANDMARK_ALGORITHM;
+    bool needHierarchy = compareAll || algorithm == HIERARCHICAL_ALGORITHM;
+    if (needLandmarks || needHierarchy) cout << endl;
+    if (needLandmarks) prepareLandmarks(solver, &maze, landmarkCount);
+    if (needHierarchy) prepareHierarchy(solver);
     
-    int path[MAX_NODES];
+    int* path = new int[solver.getMaxPathLength() + 1];
     int pathLen = 0;
     int nodesVisited = 0;
     bool found = false;
     
-    clock_t startTime, endTime;
+    // Wall-clock time: clock() would add up CPU time across the parallel solvers' threads
+    chrono::steady_clock::time_point startTime;
 
     double timeTaken;
     
-    if (choice >= 1 && choice <= 3) {
-        startTime = clock();
+    if (algorithm >= 0) {
+        cout << "\nRunning " << ALGORITHM_NAMES[algorithm] << "..." << endl;
+        startTime = chrono::steady_clock::now();
         
-        switch (choice) {
-            case 1:
-
-                cout << "\nRunning BFS..." << endl;
-                found = solver.solveBFS(path, pathLen, nodesVisited);
-                break;
-
-            case 2:
-
-                cout << "\nRunning DFS (Stack)..." << endl;
-                found = solver.solveDFSStack(path, pathLen, nodesVisited);
-                break;
-
-            case 3:
-
-                cout << "\nRunning DFS (Recursive)..." << endl;
-                found = solver.solveDFSRecursive(path, pathLen, nodesVisited);
-                break;
-
-        }
+        found = runAlgorithm(solver, algorithm, path, pathLen, nodesVisited);
         
-        endTime = clock();
-
-        timeTaken = double(endTime - startTime) / CLOCKS_PER_SEC * 1000;
+        timeTaken = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
         
         if (found) {
 
 
             cout << "\n✓ Path found!" << endl;
             cout << "Path length: " << pathLen << " steps" << endl;
+            if (maze.hasWeights()) {
+                cout << "Path cost: " << maze.getPathCost(path, pathLen) << endl;
+            }
             cout << "Nodes visited: " << nodesVisited << endl;
             cout << "Time taken: " << fixed << setprecision(3) << timeTaken << " ms" << endl;
+            cout << "Peak memory: " << getPeakMemoryKB() << " KB" << endl;
 
             
-            cout << "\nSolved Maze (path marked with *):" << endl;
-            maze.displayWithPath(path, pathLen);
+            if ((long long)maze.getRows() * maze.getCols() <= MAX_DISPLAY_CELLS) {
+                cout << "\nSolved Maze (path marked with *):" << endl;
+                maze.displayWithPath(path, pathLen);
+            }
 
             
             // Save to file
@@ -910,21 +9023,25 @@ int main() {
             outFile << "Algorithm: ";
 
 
-            if (choice == 1) outFile << "BFS";
-            else if (choice == 2) outFile << "DFS (Stack)";
-            else outFile << "DFS (Recursive)";
+            outFile << ALGORITHM_NAMES[algorithm];
 
 
             outFile << "\nPath found: Yes";
             outFile << "\nPath length: " << pathLen;
+            if (maze.hasWeights()) outFile << "\nPath cost: " << maze.getPathCost(path, pathLen);
             outFile << "\nNodes visited: " << nodesVisited;
-            outFile << "\nTime taken: " << timeTaken << " ms\n\n";
+            outFile << "\nTime taken: " << timeTaken << " ms";
+            outFile << "\nPeak memory: " << getPeakMemoryKB() << " KB\n\n";
 
 
             outFile.close();
             
             cout << "\nResults saved to 'output.txt'" << endl;
 
+        } else if (algorithmLimitation(algorithm, &maze) != NULL) {
+
+            cout << "\n✗ " << algorithmLimitation(algorithm, &maze) << endl;
+
         } else {
 
             cout << "\n✗ No path found!" << endl;
@@ -932,71 +9049,77 @@ int main() {
         }
         
         
-    } else if (choice == 4) {
+    } else if (compareAll) {
         cout << "\n=====================================" << endl;
         cout << "   COMPARING ALL ALGORITHMS" << endl;
         cout << "=====================================" << endl;
         
-        double times[3];
-        int visits[3];
-        int lengths[3];
-        const char* names[] = {"BFS", "DFS (Stack)", "DFS (Recursive)"};
+        double times[ALGORITHM_COUNT];
+        int visits[ALGORITHM_COUNT];
         
-        for (int i = 0; i < 3; i++) {
-            startTime = clock();
+        for (int i = 0; i < ALGORITHM_COUNT; i++) {
+            startTime = chrono::steady_clock::now();
             
-            switch (i) {
-
-                case 0: 
-                found = solver.solveBFS(path, pathLen, nodesVisited); 
-
-                    break;
-
-                case 1:
-
-                 found = solver.solveDFSStack(path, pathLen, nodesVisited);
-
-                     break;
-
-                case 2: 
-                found = solver.solveDFSRecursive(path, pathLen, nodesVisited);
-
-                     break;
-
-            }
+            found = runAlgorithm(solver, i, path, pathLen, nodesVisited);
             
-            endTime = clock();
-            times[i] = double(endTime - startTime) / CLOCKS_PER_SEC * 1000;
+            times[i] = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
             visits[i] = nodesVisited;
-            lengths[i] = pathLen;
             
-            cout << "\n" << names[i] << ":" << endl;
+            cout << "\n" << ALGORITHM_NAMES[i] << ":" << endl;
+            if (algorithmLimitation(i, &maze) != NULL) cout << "  Skipped: " << algorithmLimitation(i, &maze) << endl;
             cout << "  Path length: " << pathLen << endl;
-            cout << "  Nodes visited: " << nodesVisited << endl;
+            if (maze.hasWeights()) {
+                cout << "  Path cost: " << maze.getPathCost(path, pathLen) << endl;
+            }
+            cout << "  Nodes visited: " << nodesVisited;
+            if (i > 0 && visits[0] > 0) {
+                cout << " (" << fixed << setprecision(1) << 100.0 * nodesVisited / visits[0] << "% of BFS)";
+            }
+            cout << endl;
             cout << "  Time: " << fixed << setprecision(3) << times[i] << " ms" << endl;
         }
         
         // Demonstrate sorting
         cout << "\n=====================================" << endl;
         cout << "SORTING ANALYSIS (by time)" << endl;
-        double timesCopy[3];
-        for (int i = 0; i < 3; i++) timesCopy[i] = times[i];
+        double timesCopy[ALGORITHM_COUNT];
+        for (int i = 0; i < ALGORITHM_COUNT; i++) timesCopy[i] = times[i];
         
-        bubbleSort(timesCopy, 3);
+        bubbleSort(timesCopy, ALGORITHM_COUNT);
         
         cout << "Sorted times (Bubble Sort):" << endl;
-        for (int i = 0; i < 3; i++) {
+        for (int i = 0; i < ALGORITHM_COUNT; i++) {
             cout << "  " << fixed << setprecision(3) << timesCopy[i] << " ms" << endl;
         }
         
-        insertionSort(visits, 3);
+        insertionSort(visits, ALGORITHM_COUNT);
         cout << "\nSorted nodes visited (Insertion Sort):" << endl;
-        for (int i = 0; i < 3; i++) {
+        for (int i = 0; i < ALGORITHM_COUNT; i++) {
             cout << "  " << visits[i] << " nodes" << endl;
         }
         
+        // Parallel BFS at 1, 2, 4, ... threads up to the --threads setting
+        cout << "\n=====================================" << endl;
+        cout << "PARALLEL BFS SCALING" << endl;
+        double baseTime = 0;
+        for (int t = 1; ; t *= 2) {
+            if (t > threads) t = threads;
+            solver.setThreadCount(t);
+            chrono::steady_clock::time_point scaleStart = chrono::steady_clock::now();
+            found = solver.solveParallelBFS(path, pathLen, nodesVisited);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - scaleStart).count();
+            if (t == 1) baseTime = ms;
+            cout << "  " << setw(3) << t << " threads: " << fixed << setprecision(3) << ms << " ms";
+            if (ms > 0) cout << "  (speedup " << setprecision(2) << baseTime / ms << "x)";
+            cout << endl;
+            if (t == threads) break;
+        }
+        solver.setThreadCount(threads);
+        
+        cout << "\nPeak memory: " << getPeakMemoryKB() << " KB" << endl;
         cout << "=====================================" << endl;
     }
     
+    delete[] path;
     return 0;
 }
\ No newline at end of file